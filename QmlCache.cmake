@@ -0,0 +1,51 @@
+# qmlcachegen: ahead of time compilation for the installed qml packages
+# Qt loads the <file>.qmlc/<file>.jsc cache that is found next to a qml/js source file
+# as long as it was generated from the same source and with the same Qt version
+if(ENABLE_QML_CACHE)
+    if(Qt5Qml_VERSION VERSION_LESS "5.11.0")
+        message(WARNING "-- qmlcachegen: Qt ${Qt5Qml_VERSION} is not supported, Qt >= 5.11 is needed")
+        set(ENABLE_QML_CACHE OFF)
+    else()
+        get_target_property(QMAKE_EXECUTABLE Qt5::qmake IMPORTED_LOCATION)
+        get_filename_component(QT_BINARIES_DIR ${QMAKE_EXECUTABLE} DIRECTORY)
+
+        find_program(QMLCACHEGEN_EXECUTABLE NAMES qmlcachegen qmlcachegen-qt5 HINTS ${QT_BINARIES_DIR})
+
+        if(EXISTS "${QMLCACHEGEN_EXECUTABLE}")
+            message(STATUS "Found qmlcachegen: ${QMLCACHEGEN_EXECUTABLE}")
+        else()
+            message(WARNING "-- qmlcachegen: not found, qml packages will be compiled at runtime")
+            set(ENABLE_QML_CACHE OFF)
+        endif()
+    endif()
+endif()
+
+# latte_install_qml_cache(<target> <package source dir> <package install dir>)
+# precompiles all qml/js files of the package and installs their cache files next to them
+function(latte_install_qml_cache target package_dir install_dir)
+    if(NOT ENABLE_QML_CACHE)
+        return()
+    endif()
+
+    file(GLOB_RECURSE qml_files RELATIVE ${package_dir} ${package_dir}/*.qml ${package_dir}/*.js)
+
+    set(cache_files)
+
+    foreach(qml_file ${qml_files})
+        set(cache_file ${CMAKE_CURRENT_BINARY_DIR}/qmlcache/${target}/${qml_file}c)
+        get_filename_component(cache_subdir ${qml_file} DIRECTORY)
+
+        add_custom_command(OUTPUT ${cache_file}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${CMAKE_CURRENT_BINARY_DIR}/qmlcache/${target}/${cache_subdir}
+            COMMAND ${QMLCACHEGEN_EXECUTABLE} -o ${cache_file} ${package_dir}/${qml_file}
+            DEPENDS ${package_dir}/${qml_file}
+            COMMENT "Precompiling ${target}/${qml_file}")
+
+        # source timestamps are preserved during installation, so the cache remains valid
+        install(FILES ${cache_file} DESTINATION ${install_dir}/${cache_subdir})
+
+        list(APPEND cache_files ${cache_file})
+    endforeach()
+
+    add_custom_target(${target}-qmlcache ALL DEPENDS ${cache_files})
+endfunction()
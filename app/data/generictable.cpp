@@ -25,6 +25,9 @@
 
 #include <QDebug>
 
+// C++
+#include <algorithm>
+
 namespace Latte {
 namespace Data {
 
@@ -35,14 +38,26 @@ GenericTable<T>::GenericTable()
 
 template <class T>
 GenericTable<T>::GenericTable(GenericTable<T> &&o)
-    : m_list(o.m_list)
+    : m_list(o.m_list),
+      m_indexDirty(o.m_indexDirty),
+      m_hasDuplicateIds(o.m_hasDuplicateIds),
+      m_sortedById(o.m_sortedById),
+      m_sortedByName(o.m_sortedByName),
+      m_ids(o.m_ids),
+      m_changedRows(o.m_changedRows)
 {
 
 }
 
 template <class T>
 GenericTable<T>::GenericTable(const GenericTable<T> &o)
-    : m_list(o.m_list)
+    : m_list(o.m_list),
+      m_indexDirty(o.m_indexDirty),
+      m_hasDuplicateIds(o.m_hasDuplicateIds),
+      m_sortedById(o.m_sortedById),
+      m_sortedByName(o.m_sortedByName),
+      m_ids(o.m_ids),
+      m_changedRows(o.m_changedRows)
 {
 
 }
@@ -53,6 +68,13 @@ GenericTable<T> &GenericTable<T>::operator=(const GenericTable<T> &rhs)
 {
     m_list = rhs.m_list;
 
+    m_indexDirty = rhs.m_indexDirty;
+    m_hasDuplicateIds = rhs.m_hasDuplicateIds;
+    m_sortedById = rhs.m_sortedById;
+    m_sortedByName = rhs.m_sortedByName;
+    m_ids = rhs.m_ids;
+    m_changedRows = rhs.m_changedRows;
+
     return (*this);
 }
 
@@ -60,6 +82,14 @@ template <class T>
 GenericTable<T> &GenericTable<T>::operator=(GenericTable<T> &&rhs)
 {
     m_list = rhs.m_list;
+
+    m_indexDirty = rhs.m_indexDirty;
+    m_hasDuplicateIds = rhs.m_hasDuplicateIds;
+    m_sortedById = rhs.m_sortedById;
+    m_sortedByName = rhs.m_sortedByName;
+    m_ids = rhs.m_ids;
+    m_changedRows = rhs.m_changedRows;
+
     return (*this);
 }
 
@@ -67,7 +97,9 @@ template <class T>
 GenericTable<T> &GenericTable<T>::operator<<(const T &rhs)
 {
     if (!rhs.id.isEmpty()) {
+        updateIndex();
         m_list << rhs;
+        indexInsertedRow(m_list.count() - 1);
     }
 
     return (*this);
@@ -76,14 +108,22 @@ GenericTable<T> &GenericTable<T>::operator<<(const T &rhs)
 template <class T>
 GenericTable<T> &GenericTable<T>::operator<<(const GenericTable<T> &rhs)
 {
-    m_list << rhs.m_list;
+    updateIndex();
+
+    for (int i=0; i<rhs.m_list.count(); ++i) {
+        m_list << rhs.m_list[i];
+        indexInsertedRow(m_list.count() - 1);
+    }
+
     return (*this);
 }
 
 template <class T>
 GenericTable<T> &GenericTable<T>::insert(const int &pos, const T &rhs)
 {
+    updateIndex();
     m_list.insert(pos, rhs);
+    indexInsertedRow(qBound(0, pos, m_list.count() - 1));
     return (*this);
 }
 
@@ -111,9 +151,9 @@ bool GenericTable<T>::operator==(const GenericTable<T> &rhs) const
     }
 
     for(int i=0; i<m_list.count(); ++i) {
-        QString id = m_list[i].id;
+        int rhsPos = rhs.indexOf(m_list[i].id);
 
-        if (!rhs.containsId(id) || (*this)[id] != rhs[id]){
+        if (rhsPos < 0 || m_list[indexOf(m_list[i].id)] != rhs.m_list[rhsPos]){
             return false;
         }
     }
@@ -130,14 +170,10 @@ bool GenericTable<T>::operator!=(const GenericTable<T> &rhs) const
 template <class T>
 T &GenericTable<T>::operator[](const QString &id)
 {
-    int pos{-1};
+    int pos = indexOf(id);
 
-    for(int i=0; i<m_list.count(); ++i) {
-        if (m_list[i].id == id){
-            pos = i;
-            break;
-        }
-    }
+    //! the record can be changed through the returned reference
+    trackChangedRow(pos);
 
     return m_list[pos];
 }
@@ -145,14 +181,7 @@ T &GenericTable<T>::operator[](const QString &id)
 template <class T>
 const T GenericTable<T>::operator[](const QString &id) const
 {
-    int pos{-1};
-
-    for(int i=0; i<m_list.count(); ++i) {
-        if (m_list[i].id == id){
-            pos = i;
-            break;
-        }
-    }
+    int pos = indexOf(id);
 
     return m_list[pos];
 }
@@ -160,6 +189,9 @@ const T GenericTable<T>::operator[](const QString &id) const
 template <class T>
 T &GenericTable<T>::operator[](const uint &index)
 {
+    //! the record can be changed through the returned reference
+    trackChangedRow(index);
+
     return m_list[index];
 }
 
@@ -172,13 +204,7 @@ const T GenericTable<T>::operator[](const uint &index) const
 template <class T>
 bool GenericTable<T>::containsId(const QString &id) const
 {
-    for(int i=0; i<m_list.count(); ++i) {
-        if (m_list[i].id == id){
-            return true;
-        }
-    }
-
-    return false;
+    return indexOf(id) >= 0;
 }
 
 template <class T>
@@ -202,13 +228,9 @@ bool GenericTable<T>::rowExists(const int &row) const
 template <class T>
 int GenericTable<T>::indexOf(const QString &id) const
 {
-    for(int i=0; i<m_list.count(); ++i) {
-        if (m_list[i].id == id){
-            return i;
-        }
-    }
+    updateIndex();
 
-    return -1;
+    return indexedRow(id);
 }
 
 template <class T>
@@ -220,6 +242,16 @@ int GenericTable<T>::rowCount() const
 template <class T>
 int GenericTable<T>::sortedPosForId(const QString &id) const
 {
+    updateIndex();
+
+    if (m_sortedById) {
+        auto upper = std::upper_bound(m_list.constBegin(), m_list.constEnd(), id, [](const QString &value, const T &record) {
+            return QString::compare(value, record.id, Qt::CaseInsensitive) < 0;
+        });
+
+        return upper - m_list.constBegin();
+    }
+
     int pos{0};
 
     for(int i=0; i<m_list.count(); ++i) {
@@ -236,6 +268,16 @@ int GenericTable<T>::sortedPosForId(const QString &id) const
 template <class T>
 int GenericTable<T>::sortedPosForName(const QString &name) const
 {
+    updateIndex();
+
+    if (m_sortedByName) {
+        auto upper = std::upper_bound(m_list.constBegin(), m_list.constEnd(), name, [](const QString &value, const T &record) {
+            return QString::compare(value, record.name, Qt::CaseInsensitive) < 0;
+        });
+
+        return upper - m_list.constBegin();
+    }
+
     int pos{0};
 
     for(int i=0; i<m_list.count(); ++i) {
@@ -277,6 +319,13 @@ template <class T>
 void GenericTable<T>::clear()
 {
     m_list.clear();
+
+    m_ids.clear();
+    m_changedRows.clear();
+    m_indexDirty = false;
+    m_hasDuplicateIds = false;
+    m_sortedById = true;
+    m_sortedByName = true;
 }
 
 template <class T>
@@ -286,6 +335,7 @@ void GenericTable<T>::remove(const QString &id)
 
     if (pos >= 0) {
         m_list.removeAt(pos);
+        indexRemovedRow(pos);
     }
 }
 
@@ -293,8 +343,154 @@ template <class T>
 void GenericTable<T>::remove(const int &row)
 {
     if (rowExists(row)) {
+        updateIndex();
         m_list.removeAt(row);
+        indexRemovedRow(row);
+    }
+}
+
+template <class T>
+void GenericTable<T>::invalidateIndex()
+{
+    m_indexDirty = true;
+    m_changedRows.clear();
+}
+
+template <class T>
+void GenericTable<T>::trackChangedRow(const int &row)
+{
+    if (m_indexDirty || !rowExists(row) || m_changedRows.contains(row)) {
+        return;
+    }
+
+    m_changedRows[row] = qMakePair(m_list[row].id, m_list[row].name);
+}
+
+//! records that were handed out through references are compared with their indexed
+//! id and name, the index is rebuilt only when one of them was really changed
+template <class T>
+void GenericTable<T>::updateChangedRows() const
+{
+    for (auto it = m_changedRows.constBegin(); it != m_changedRows.constEnd(); ++it) {
+        const T &record = m_list[it.key()];
+
+        if (record.id != it.value().first || record.name != it.value().second) {
+            m_indexDirty = true;
+            break;
+        }
     }
+
+    m_changedRows.clear();
+}
+
+template <class T>
+void GenericTable<T>::updateIndex() const
+{
+    if (!m_changedRows.isEmpty()) {
+        updateChangedRows();
+    }
+
+    if (!m_indexDirty) {
+        return;
+    }
+
+    m_ids.clear();
+    m_ids.reserve(m_list.count());
+    m_hasDuplicateIds = false;
+    m_sortedById = true;
+    m_sortedByName = true;
+
+    for(int i=0; i<m_list.count(); ++i) {
+        if (m_ids.contains(m_list[i].id)) {
+            m_hasDuplicateIds = true;
+        } else {
+            m_ids[m_list[i].id] = i;
+        }
+
+        if (i > 0) {
+            m_sortedById = m_sortedById && QString::compare(m_list[i-1].id, m_list[i].id, Qt::CaseInsensitive) <= 0;
+            m_sortedByName = m_sortedByName && QString::compare(m_list[i-1].name, m_list[i].name, Qt::CaseInsensitive) <= 0;
+        }
+    }
+
+    m_indexDirty = false;
+}
+
+template <class T>
+void GenericTable<T>::indexInsertedRow(const int &row) const
+{
+    if (m_indexDirty) {
+        return;
+    }
+
+    const QString &id = m_list[row].id;
+
+    //! rows after the inserted one are moved by one
+    if (row < m_list.count() - 1) {
+        for (auto it = m_ids.begin(); it != m_ids.end(); ++it) {
+            if (it.value() >= row) {
+                ++it.value();
+            }
+        }
+    }
+
+    //! the first record is the one found for duplicate ids
+    auto existing = m_ids.find(id);
+
+    if (existing == m_ids.end()) {
+        m_ids[id] = row;
+    } else {
+        m_hasDuplicateIds = true;
+
+        if (existing.value() > row) {
+            existing.value() = row;
+        }
+    }
+
+    if (row > 0) {
+        m_sortedById = m_sortedById && QString::compare(m_list[row-1].id, id, Qt::CaseInsensitive) <= 0;
+        m_sortedByName = m_sortedByName && QString::compare(m_list[row-1].name, m_list[row].name, Qt::CaseInsensitive) <= 0;
+    }
+
+    if (row < m_list.count() - 1) {
+        m_sortedById = m_sortedById && QString::compare(id, m_list[row+1].id, Qt::CaseInsensitive) <= 0;
+        m_sortedByName = m_sortedByName && QString::compare(m_list[row].name, m_list[row+1].name, Qt::CaseInsensitive) <= 0;
+    }
+}
+
+template <class T>
+void GenericTable<T>::indexRemovedRow(const int &row) const
+{
+    if (m_indexDirty) {
+        return;
+    }
+
+    if (m_hasDuplicateIds) {
+        //! another record with the same id may have to be indexed
+        m_indexDirty = true;
+        return;
+    }
+
+    for (auto it = m_ids.begin(); it != m_ids.end();) {
+        if (it.value() == row) {
+            it = m_ids.erase(it);
+            continue;
+        }
+
+        if (it.value() > row) {
+            --it.value();
+        }
+
+        ++it;
+    }
+
+    //! removing records does not break the table sorting
+}
+
+template <class T>
+int GenericTable<T>::indexedRow(const QString &id) const
+{
+    return m_ids.value(id, -1);
 }
 
 //! Make linker happy and provide which table instances will be used.
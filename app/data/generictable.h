@@ -25,7 +25,9 @@
 #include "genericdata.h"
 
 // Qt
+#include <QHash>
 #include <QList>
+#include <QPair>
 
 namespace Latte {
 namespace Data {
@@ -72,10 +74,36 @@ public:
     void remove(const int &row);
     void remove(const QString &id);
 
+protected:
+    //! must be called when m_list is changed directly
+    void invalidateIndex();
+
 protected:
     //! #id, record
     QList<T> m_list;
 
+private:
+    void trackChangedRow(const int &row);
+    void updateChangedRows() const;
+    void updateIndex() const;
+    void indexInsertedRow(const int &row) const;
+    void indexRemovedRow(const int &row) const;
+
+    int indexedRow(const QString &id) const;
+
+private:
+    //! ids index, it is updated incrementally when rows are inserted and removed
+    //! and it is rebuilt lazily when records were changed through references or directly
+    mutable bool m_indexDirty{false};
+    mutable bool m_hasDuplicateIds{false};
+    mutable bool m_sortedById{true};
+    mutable bool m_sortedByName{true};
+
+    //! id, row
+    mutable QHash<QString, int> m_ids;
+
+    //! row, [id, name] of records that were handed out through non-const references
+    mutable QHash<int, QPair<QString, QString>> m_changedRows;
 };
 
 }
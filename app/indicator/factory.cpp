@@ -23,11 +23,14 @@
 #include "../layouts/importer.h"
 
 // Qt
+#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
 #include <QMessageBox>
 #include <QProcess>
+#include <QQmlComponent>
+#include <QQmlEngine>
 #include <QTemporaryDir>
 #include <QTimer>
 
@@ -49,6 +52,7 @@ Factory::Factory(QObject *parent)
     : QObject(parent)
 {
     m_parentWidget = new QWidget();
+    m_sharedComponentsEnabled = qApp->arguments().contains("--shared-indicators");
 
     m_mainPaths = Latte::Layouts::Importer::standardPaths();
 
@@ -172,6 +176,7 @@ void Factory::reload(const QString &indicatorPath)
     }
 
     if (!pluginChangedId.isEmpty()) {
+        removeSharedComponents(indicatorPath);
         emit indicatorChanged(pluginChangedId);
     }
 }
@@ -210,6 +215,7 @@ void Factory::removeIndicatorRecords(const QString &path)
         m_customLocalPluginIds.removeAll(pluginId);
 
         m_indicatorsPaths.removeAll(path);
+        removeSharedComponents(path);
 
         KDirWatch::self()->removeDir(path);
 
@@ -251,6 +257,69 @@ QString Factory::uiPath(QString pluginName) const
     return m_pluginUiPaths[pluginName];
 }
 
+QQmlComponent *Factory::sharedComponent(QQmlEngine *engine, const QString &uiFile)
+{
+    if (!m_sharedComponentsEnabled || !engine || uiFile.isEmpty()) {
+        return nullptr;
+    }
+
+    QPointer<QQmlComponent> &component = m_sharedComponents[uiFile];
+
+    if (!component) {
+        component = new QQmlComponent(engine, uiFile, engine);
+
+        QQmlComponent *key = component.data();
+        connect(key, &QObject::destroyed, this, [this, key]() {
+            m_sharedComponentsUsers.remove(key);
+        });
+    } else if (component->engine() != engine) {
+        return nullptr;
+    }
+
+    m_sharedComponentsUsers[component]++;
+
+    return component;
+}
+
+bool Factory::releaseSharedComponent(QQmlComponent *component)
+{
+    if (!component || !m_sharedComponentsUsers.contains(component)) {
+        return false;
+    }
+
+    int &users = m_sharedComponentsUsers[component];
+    users--;
+
+    //! components of updated or removed indicators are deleted when they are not used any more,
+    //! the current ones are kept for the docks and panels that will be created afterwards
+    if (users <= 0 && !m_sharedComponents.values().contains(component)) {
+        m_sharedComponentsUsers.remove(component);
+        component->deleteLater();
+    }
+
+    return true;
+}
+
+void Factory::removeSharedComponents(const QString &indicatorPath)
+{
+    QString path = indicatorPath.endsWith("/") ? indicatorPath : indicatorPath + "/";
+
+    for (auto it = m_sharedComponents.begin(); it != m_sharedComponents.end();) {
+        if (!it.key().startsWith(path)) {
+            ++it;
+            continue;
+        }
+
+        QQmlComponent *component = it.value().data();
+        it = m_sharedComponents.erase(it);
+
+        if (component && m_sharedComponentsUsers.value(component, 0) <= 0) {
+            m_sharedComponentsUsers.remove(component);
+            component->deleteLater();
+        }
+    }
+}
+
 Latte::ImportExport::State Factory::importIndicatorFile(QString compressedFile)
 {
     auto showNotificationError = []() {
@@ -26,9 +26,12 @@
 // Qt
 #include <QHash>
 #include <QObject>
+#include <QPointer>
 #include <QWidget>
 
 class KPluginMetaData;
+class QQmlComponent;
+class QQmlEngine;
 
 namespace Latte {
 namespace Indicator {
@@ -56,6 +59,14 @@ public:
 
     QString uiPath(QString pluginName) const;
 
+    //! when latte is started with --shared-indicators, indicator components are compiled
+    //! once for each ui file and they are shared between all docks and panels. It returns
+    //! nullptr when sharing is disabled or the component was compiled for another engine,
+    //! in such case the caller creates its own component
+    QQmlComponent *sharedComponent(QQmlEngine *engine, const QString &uiFile);
+    //! returns false when the component is not shared, in such case the caller deletes it
+    bool releaseSharedComponent(QQmlComponent *component);
+
     //! metadata record
     static bool metadataAreValid(KPluginMetaData &metadata);
     //! metadata file
@@ -71,12 +82,20 @@ private:
     void reload(const QString &indicatorPath);
 
     void removeIndicatorRecords(const QString &path);
+    void removeSharedComponents(const QString &indicatorPath);
     void discoverNewIndicators(const QString &main);
 
 private:
+    bool m_sharedComponentsEnabled{false};
+
     QHash<QString, KPluginMetaData> m_plugins;
     QHash<QString, QString> m_pluginUiPaths;
 
+    //! ui file -> shared component
+    QHash<QString, QPointer<QQmlComponent>> m_sharedComponents;
+    //! shared component -> indicators that are using it
+    QHash<QQmlComponent *, int> m_sharedComponentsUsers;
+
     QStringList m_customPluginIds;
     QStringList m_customPluginNames;
     QStringList m_customLocalPluginIds;
@@ -92,6 +92,9 @@
 #include <KWayland/Client/plasmashell.h>
 #include <KWayland/Client/plasmawindowmanagement.h>
 
+// C++
+#include <algorithm>
+
 namespace Latte {
 
 Corona::Corona(bool defaultLayoutOnStartup, QString layoutNameOnStartUp, int userSetMemoryUsage, QObject *parent)
@@ -122,6 +125,21 @@ Corona::Corona(bool defaultLayoutOnStartup, QString layoutNameOnStartUp, int use
 
     setupWaylandIntegration();
 
+    //! available screen geometries cache must be invalidated before any other consumer is informed
+    connect(this, &Corona::availableScreenRectChangedFrom, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(this, &Corona::availableScreenRegionChangedFrom, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(this, &Plasma::Corona::availableScreenRectChanged, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(this, &Plasma::Corona::availableScreenRegionChanged, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(this, &Corona::viewLocationChanged, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(m_activitiesConsumer, &KActivities::Consumer::currentActivityChanged, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(m_activitiesConsumer, &KActivities::Consumer::runningActivitiesChanged, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(m_layoutsManager->synchronizer(), &Layouts::Synchronizer::centralLayoutsChanged, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(m_layoutsManager->synchronizer(), &Layouts::Synchronizer::layoutsChanged, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(m_layoutsManager->synchronizer(), &Layouts::Synchronizer::layoutActivitiesChanged, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(qGuiApp, &QGuiApplication::screenAdded, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(qGuiApp, &QGuiApplication::screenRemoved, this, &Corona::invalidateAvailableScreenGeometries);
+    connect(m_screenPool, &ScreenPool::primaryPoolChanged, this, &Corona::invalidateAvailableScreenGeometries);
+
     KPackage::Package package(new Latte::Package(this));
 
     m_screenPool->load();
@@ -526,6 +544,55 @@ Layout::GenericLayout *Corona::layout(QString name) const
     return result;
 }
 
+QString Corona::availableScreenGeometryKey(int id,
+                                           const QString &activityid,
+                                           const QList<Types::Visibility> &ignoreModes,
+                                           const QList<Plasma::Types::Location> &ignoreEdges,
+                                           bool ignoreExternalPanels,
+                                           bool desktopUse) const
+{
+    //! None and NormalWindow modes are always ignored during calculations
+    QList<int> modes;
+    modes << Latte::Types::None << Latte::Types::NormalWindow;
+
+    for (const auto mode : ignoreModes) {
+        if (!modes.contains(mode)) {
+            modes << mode;
+        }
+    }
+
+    QList<int> edges;
+
+    for (const auto edge : ignoreEdges) {
+        if (!edges.contains(edge)) {
+            edges << edge;
+        }
+    }
+
+    std::sort(modes.begin(), modes.end());
+    std::sort(edges.begin(), edges.end());
+
+    QStringList modesStr;
+    QStringList edgesStr;
+
+    for (const auto mode : modes) {
+        modesStr << QString::number(mode);
+    }
+
+    for (const auto edge : edges) {
+        edgesStr << QString::number(edge);
+    }
+
+    return QString::number(id) + "|" + activityid + "|" + modesStr.join(",") + "|" + edgesStr.join(",")
+            + "|" + QString::number(ignoreExternalPanels) + "|" + QString::number(desktopUse);
+}
+
+void Corona::invalidateAvailableScreenGeometries()
+{
+    m_availableScreenRects.clear();
+    m_availableScreenRegions.clear();
+}
+
 QRegion Corona::availableScreenRegion(int id) const
 {
     return availableScreenRegionWithCriteria(id);
@@ -539,22 +606,35 @@ QRegion Corona::availableScreenRegionWithCriteria(int id,
                                                   bool desktopUse) const
 {
     const QScreen *screen = m_screenPool->screenForId(id);
-    bool inCurrentActivity{activityid.isEmpty()};
 
     if (!screen) {
         return {};
     }
 
-    QRegion available = ignoreExternalPanels ? screen->geometry() : screen->availableGeometry();
+    if (activityid.isEmpty()) {
+        activityid = m_activitiesConsumer->currentActivity();
+    }
 
-    QList<Latte::View *> views;
+    QString key = availableScreenGeometryKey(id, activityid, ignoreModes, ignoreEdges, ignoreExternalPanels, desktopUse);
 
-    if (inCurrentActivity) {
-        views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(m_activitiesConsumer->currentActivity());
-    } else {
-        views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(activityid);
+    if (!m_availableScreenRegions.contains(key)) {
+        m_availableScreenRegions[key] = calculateAvailableScreenRegion(screen, activityid, ignoreModes, ignoreEdges, ignoreExternalPanels, desktopUse);
     }
 
+    return m_availableScreenRegions[key];
+}
+
+QRegion Corona::calculateAvailableScreenRegion(const QScreen *screen,
+                                               const QString &activityid,
+                                               QList<Types::Visibility> ignoreModes,
+                                               const QList<Plasma::Types::Location> &ignoreEdges,
+                                               bool ignoreExternalPanels,
+                                               bool desktopUse) const
+{
+    QRegion available = ignoreExternalPanels ? screen->geometry() : screen->availableGeometry();
+
+    QList<Latte::View *> views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(activityid);
+
     if (views.isEmpty()) {
         return available;
     }
@@ -733,22 +813,35 @@ QRect Corona::availableScreenRectWithCriteria(int id,
                                               bool desktopUse) const
 {
     const QScreen *screen = m_screenPool->screenForId(id);
-    bool inCurrentActivity{activityid.isEmpty()};
 
     if (!screen) {
         return {};
     }
 
-    QRect available = ignoreExternalPanels ? screen->geometry() : screen->availableGeometry();
+    if (activityid.isEmpty()) {
+        activityid = m_activitiesConsumer->currentActivity();
+    }
 
-    QList<Latte::View *> views;
+    QString key = availableScreenGeometryKey(id, activityid, ignoreModes, ignoreEdges, ignoreExternalPanels, desktopUse);
 
-    if (inCurrentActivity) {
-        views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(m_activitiesConsumer->currentActivity());
-    } else {
-        views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(activityid);
+    if (!m_availableScreenRects.contains(key)) {
+        m_availableScreenRects[key] = calculateAvailableScreenRect(screen, activityid, ignoreModes, ignoreEdges, ignoreExternalPanels, desktopUse);
     }
 
+    return m_availableScreenRects[key];
+}
+
+QRect Corona::calculateAvailableScreenRect(const QScreen *screen,
+                                           const QString &activityid,
+                                           QList<Types::Visibility> ignoreModes,
+                                           const QList<Plasma::Types::Location> &ignoreEdges,
+                                           bool ignoreExternalPanels,
+                                           bool desktopUse) const
+{
+    QRect available = ignoreExternalPanels ? screen->geometry() : screen->availableGeometry();
+
+    QList<Latte::View *> views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(activityid);
+
     if (views.isEmpty()) {
         return available;
     }
@@ -833,7 +926,11 @@ void Corona::addOutput(QScreen *screen)
         m_screenPool->insertScreenMapping(newId, screen->name());
     }
 
+    connect(screen, &QScreen::availableGeometryChanged, this, &Corona::invalidateAvailableScreenGeometries);
+
     connect(screen, &QScreen::geometryChanged, this, [ = ]() {
+        invalidateAvailableScreenGeometries();
+
         const int id = m_screenPool->id(screen->name());
 
         if (id >= 0) {
@@ -28,7 +28,10 @@
 #include "view/panelshadows_p.h"
 
 // Qt
+#include <QHash>
 #include <QObject>
+#include <QRegion>
+#include <QScreen>
 #include <QTimer>
 
 // Plasma
@@ -130,6 +133,10 @@ public:
                                               bool ignoreExternalPanels = true,
                                               bool desktopUse = false) const;
 
+    //! available screen geometries are cached and must be invalidated whenever
+    //! a view geometry, visibility mode, activities or screens are changed
+    void invalidateAvailableScreenGeometries();
+
     int screenForContainment(const Plasma::Containment *containment) const override;
 
     KWayland::Client::PlasmaShell *waylandCoronaInterface() const;
@@ -206,6 +213,27 @@ private:
 
     int primaryScreenId() const;
 
+    QRect calculateAvailableScreenRect(const QScreen *screen,
+                                       const QString &activityid,
+                                       QList<Types::Visibility> ignoreModes,
+                                       const QList<Plasma::Types::Location> &ignoreEdges,
+                                       bool ignoreExternalPanels,
+                                       bool desktopUse) const;
+
+    QRegion calculateAvailableScreenRegion(const QScreen *screen,
+                                           const QString &activityid,
+                                           QList<Types::Visibility> ignoreModes,
+                                           const QList<Plasma::Types::Location> &ignoreEdges,
+                                           bool ignoreExternalPanels,
+                                           bool desktopUse) const;
+
+    QString availableScreenGeometryKey(int id,
+                                       const QString &activityid,
+                                       const QList<Types::Visibility> &ignoreModes,
+                                       const QList<Plasma::Types::Location> &ignoreEdges,
+                                       bool ignoreExternalPanels,
+                                       bool desktopUse) const;
+
     QStringList containmentsIds();
     QStringList appletsIds();
 
@@ -231,6 +259,10 @@ private:
 
     QTimer m_viewsScreenSyncTimer;
 
+    //! criteria key, available screen geometry
+    mutable QHash<QString, QRect> m_availableScreenRects;
+    mutable QHash<QString, QRegion> m_availableScreenRegions;
+
     KActivities::Consumer *m_activitiesConsumer;
     QPointer<KAboutApplicationDialog> aboutDialog;
 
@@ -27,6 +27,7 @@
 #include "../screenpool.h"
 #include "../layout/abstractlayout.h"
 #include "../settings/universalsettings.h"
+#include "../tools/archivetools.h"
 
 // Qt
 #include <QFile>
@@ -35,6 +36,7 @@
 #include <KArchive/KTar>
 #include <KArchive/KArchiveEntry>
 #include <KArchive/KArchiveDirectory>
+#include <KConfig>
 #include <KConfigGroup>
 #include <KLocalizedString>
 #include <KNotification>
@@ -436,52 +438,38 @@ Importer::LatteFileVersion Importer::fileVersion(QString file)
         return Importer::UnknownFileType;
     }
 
-    QTemporaryDir archiveTempDir;
+    //! entries are identified from the archive index and only the config
+    //! files whose version is needed are read in memory
+    const KArchiveDirectory *rootDir = archive.directory();
+
+    if (!rootDir) {
+        return Importer::UnknownFileType;
+    }
 
     bool version1rc = false;
     bool version1applets = false;
 
     bool version2rc = false;
     bool version2LatteDir = false;
-    bool version2layout = false;
-
-    archive.directory()->copyTo(archiveTempDir.path());
-
 
     //rc file
-    QString rcFile(archiveTempDir.path() + "/lattedockrc");
+    int rcVersion = archivedConfigVersion(rootDir, "lattedockrc", "UniversalSettings");
 
-    if (QFile(rcFile).exists()) {
-        KSharedConfigPtr lConfig = KSharedConfig::openConfig(rcFile);
-        KConfigGroup universalGroup = KConfigGroup(lConfig, "UniversalSettings");
-        int version = universalGroup.readEntry("version", 1);
-
-        if (version == 1) {
-            version1rc = true;
-        } else if (version == 2) {
-            version2rc = true;
-        }
+    if (rcVersion == 1) {
+        version1rc = true;
+    } else if (rcVersion == 2) {
+        version2rc = true;
     }
 
     //applets file
-    QString appletsFile(archiveTempDir.path() + "/lattedock-appletsrc");
-
-    if (QFile(appletsFile).exists() && version1rc) {
-        KSharedConfigPtr lConfig = KSharedConfig::openConfig(appletsFile);
-        KConfigGroup generalGroup = KConfigGroup(lConfig, "LayoutSettings");
-        int version = generalGroup.readEntry("version", 1);
-
-        if (version == 1) {
-            version1applets = true;
-        } else if (version == 2) {
-            version2layout = true;
-        }
+    if (version1rc && archivedConfigVersion(rootDir, "lattedock-appletsrc", "LayoutSettings") == 1) {
+        version1applets = true;
     }
 
     //latte directory
-    QString latteDir(archiveTempDir.path() + "/latte");
+    const KArchiveEntry *latteDir = rootDir->entry("latte");
 
-    if (QDir(latteDir).exists()) {
+    if (latteDir && latteDir->isDirectory()) {
         version2LatteDir = true;
     }
 
@@ -42,12 +42,73 @@ LaunchersSignals::LaunchersSignals(QObject *parent)
     : QObject(parent)
 {
     m_manager = qobject_cast<Layouts::Manager *>(parent);
+
+    //! manager has not assigned its corona yet
+    Latte::Corona *corona = m_manager ? qobject_cast<Latte::Corona *>(m_manager->parent()) : nullptr;
+
+    if (corona) {
+        connect(corona, &Plasma::Corona::containmentAdded, this, &LaunchersSignals::onContainmentAdded);
+
+        for (const auto containment : corona->containments()) {
+            onContainmentAdded(containment);
+        }
+    }
 }
 
 LaunchersSignals::~LaunchersSignals()
 {
 }
 
+void LaunchersSignals::onContainmentAdded(Plasma::Containment *containment)
+{
+    if (!containment || m_lattePlasmoids.contains(containment)) {
+        return;
+    }
+
+    m_lattePlasmoids[containment] = QList<Plasma::Applet *>();
+
+    connect(containment, &Plasma::Containment::appletAdded, this, &LaunchersSignals::onAppletAdded);
+    //! applets moved to another containment are removed from their previous one
+    connect(containment, &Plasma::Containment::appletRemoved, this, [&, containment](Plasma::Applet *applet) {
+        removeLattePlasmoid(containment, applet);
+    });
+
+    connect(containment, &QObject::destroyed, this, [&, containment]() {
+        for (const auto applet : m_lattePlasmoids.take(containment)) {
+            m_methodTargets.remove(applet);
+        }
+    });
+
+    //! applets that were restored before the containment was announced
+    for (const auto applet : containment->applets()) {
+        onAppletAdded(applet);
+    }
+}
+
+void LaunchersSignals::onAppletAdded(Plasma::Applet *applet)
+{
+    if (!applet || !applet->containment() || !m_lattePlasmoids.contains(applet->containment())) {
+        return;
+    }
+
+    QList<Plasma::Applet *> &applets = m_lattePlasmoids[applet->containment()];
+
+    if (applets.contains(applet) || applet->kPackage().metadata().pluginId() != "org.kde.latte.plasmoid") {
+        return;
+    }
+
+    applets << applet;
+}
+
+void LaunchersSignals::removeLattePlasmoid(Plasma::Containment *containment, Plasma::Applet *applet)
+{
+    if (m_lattePlasmoids.contains(containment)) {
+        m_lattePlasmoids[containment].removeAll(applet);
+    }
+
+    m_methodTargets.remove(applet);
+}
+
 QList<Plasma::Applet *> LaunchersSignals::lattePlasmoids(QString layoutName)
 {
     QList<Plasma::Applet *> applets;
@@ -62,16 +123,45 @@ QList<Plasma::Applet *> LaunchersSignals::lattePlasmoids(QString layoutName)
     }
 
     for(const auto containment : containments) {
-        for(auto *applet : containment->applets()) {
-            KPluginMetaData meta = applet->kPackage().metadata();
+        applets << m_lattePlasmoids.value(containment);
+    }
+
+    return applets;
+}
+
+QList<LaunchersSignals::MethodTarget> LaunchersSignals::methodTargets(Plasma::Applet *applet, const QByteArray &signature)
+{
+    QList<MethodTarget> &targets = m_methodTargets[applet][signature];
+    bool targetsAreValid{!targets.isEmpty()};
 
-            if (meta.pluginId() == "org.kde.latte.plasmoid") {
-                applets.append(applet);
+    for (const auto &target : targets) {
+        if (!target.item) {
+            targetsAreValid = false;
+            break;
+        }
+    }
+
+    if (targetsAreValid) {
+        return targets;
+    }
+
+    targets.clear();
+
+    if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
+        for (QQuickItem *item : appletInterface->childItems()) {
+            if (auto *metaObject = item->metaObject()) {
+                int methodIndex = metaObject->indexOfMethod(signature.constData());
+
+                if (methodIndex == -1) {
+                    continue;
+                }
+
+                targets << MethodTarget{item, metaObject->method(methodIndex)};
             }
         }
     }
 
-    return applets;
+    return targets;
 }
 
 void LaunchersSignals::addLauncher(QString layoutName, int launcherGroup, QString launcher)
@@ -85,25 +175,8 @@ void LaunchersSignals::addLauncher(QString layoutName, int launcherGroup, QStrin
     QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
 
     for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
-
-            if (childItems.isEmpty()) {
-                continue;
-            }
-
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalAddLauncher(QVariant,QVariant)");
-
-                    if (methodIndex == -1) {
-                        continue;
-                    }
-
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher));
-                }
-            }
+        for (const auto &target : methodTargets(applet, "extSignalAddLauncher(QVariant,QVariant)")) {
+            target.method.invoke(target.item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher));
         }
     }
 }
@@ -119,25 +192,8 @@ void LaunchersSignals::removeLauncher(QString layoutName, int launcherGroup, QSt
     QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
 
     for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
-
-            if (childItems.isEmpty()) {
-                continue;
-            }
-
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalRemoveLauncher(QVariant,QVariant)");
-
-                    if (methodIndex == -1) {
-                        continue;
-                    }
-
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher));
-                }
-            }
+        for (const auto &target : methodTargets(applet, "extSignalRemoveLauncher(QVariant,QVariant)")) {
+            target.method.invoke(target.item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher));
         }
     }
 }
@@ -153,25 +209,8 @@ void LaunchersSignals::addLauncherToActivity(QString layoutName, int launcherGro
     QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
 
     for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
-
-            if (childItems.isEmpty()) {
-                continue;
-            }
-
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalAddLauncherToActivity(QVariant,QVariant,QVariant)");
-
-                    if (methodIndex == -1) {
-                        continue;
-                    }
-
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher), Q_ARG(QVariant, activity));
-                }
-            }
+        for (const auto &target : methodTargets(applet, "extSignalAddLauncherToActivity(QVariant,QVariant,QVariant)")) {
+            target.method.invoke(target.item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher), Q_ARG(QVariant, activity));
         }
     }
 }
@@ -187,25 +226,8 @@ void LaunchersSignals::removeLauncherFromActivity(QString layoutName, int launch
     QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
 
     for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
-
-            if (childItems.isEmpty()) {
-                continue;
-            }
-
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalRemoveLauncherFromActivity(QVariant,QVariant,QVariant)");
-
-                    if (methodIndex == -1) {
-                        continue;
-                    }
-
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher), Q_ARG(QVariant, activity));
-                }
-            }
+        for (const auto &target : methodTargets(applet, "extSignalRemoveLauncherFromActivity(QVariant,QVariant,QVariant)")) {
+            target.method.invoke(target.item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher), Q_ARG(QVariant, activity));
         }
     }
 }
@@ -221,25 +243,8 @@ void LaunchersSignals::urlsDropped(QString layoutName, int launcherGroup, QStrin
     QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
 
     for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
-
-            if (childItems.isEmpty()) {
-                continue;
-            }
-
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalUrlsDropped(QVariant,QVariant)");
-
-                    if (methodIndex == -1) {
-                        continue;
-                    }
-
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, urls));
-                }
-            }
+        for (const auto &target : methodTargets(applet, "extSignalUrlsDropped(QVariant,QVariant)")) {
+            target.method.invoke(target.item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, urls));
         }
     }
 }
@@ -256,25 +261,8 @@ void LaunchersSignals::moveTask(QString layoutName, uint senderId, int launcherG
 
     for(const auto applet : lattePlasmoids(lName)) {
         if (applet->id() != senderId) {
-            if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-                const auto &childItems = appletInterface->childItems();
-
-                if (childItems.isEmpty()) {
-                    continue;
-                }
-
-                for (QQuickItem *item : childItems) {
-                    if (auto *metaObject = item->metaObject()) {
-                        int methodIndex = metaObject->indexOfMethod("extSignalMoveTask(QVariant,QVariant,QVariant)");
-
-                        if (methodIndex == -1) {
-                            continue;
-                        }
-
-                        QMetaMethod method = metaObject->method(methodIndex);
-                        method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, from), Q_ARG(QVariant, to));
-                    }
-                }
+            for (const auto &target : methodTargets(applet, "extSignalMoveTask(QVariant,QVariant,QVariant)")) {
+                target.method.invoke(target.item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, from), Q_ARG(QVariant, to));
             }
         }
     }
@@ -292,25 +280,8 @@ void LaunchersSignals::validateLaunchersOrder(QString layoutName, uint senderId,
 
     for(const auto applet : lattePlasmoids(lName)) {
         if (applet->id() != senderId) {
-            if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-                const auto &childItems = appletInterface->childItems();
-
-                if (childItems.isEmpty()) {
-                    continue;
-                }
-
-                for (QQuickItem *item : childItems) {
-                    if (auto *metaObject = item->metaObject()) {
-                        int methodIndex = metaObject->indexOfMethod("extSignalValidateLaunchersOrder(QVariant,QVariant)");
-
-                        if (methodIndex == -1) {
-                            continue;
-                        }
-
-                        QMetaMethod method = metaObject->method(methodIndex);
-                        method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launchers));
-                    }
-                }
+            for (const auto &target : methodTargets(applet, "extSignalValidateLaunchersOrder(QVariant,QVariant)")) {
+                target.method.invoke(target.item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launchers));
             }
         }
     }
@@ -22,10 +22,15 @@
 #define LAUNCHERSSIGNALS_H
 
 // Qt
+#include <QHash>
+#include <QMetaMethod>
 #include <QObject>
+#include <QPointer>
+#include <QQuickItem>
 
 namespace Plasma {
 class Applet;
+class Containment;
 }
 
 namespace Latte {
@@ -61,11 +66,29 @@ public slots:
     Q_INVOKABLE void moveTask(QString layoutName, uint senderId, int launcherGroup, int from, int to);
     Q_INVOKABLE void validateLaunchersOrder(QString layoutName, uint senderId, int launcherGroup, QStringList launchers);
 
+private slots:
+    void onContainmentAdded(Plasma::Containment *containment);
+    void onAppletAdded(Plasma::Applet *applet);
+
 private:
+    struct MethodTarget {
+        QPointer<QQuickItem> item;
+        QMetaMethod method;
+    };
+
+    void removeLattePlasmoid(Plasma::Containment *containment, Plasma::Applet *applet);
+
     QList<Plasma::Applet *> lattePlasmoids(QString layoutName);
+    QList<MethodTarget> methodTargets(Plasma::Applet *applet, const QByteArray &signature);
 
 private:
     Layouts::Manager *m_manager{nullptr};
+
+    //! containment -> latte plasmoids, it is updated when applets are added/removed
+    //! in order to avoid reading all applets metadata for every broadcast
+    QHash<Plasma::Containment *, QList<Plasma::Applet *>> m_lattePlasmoids;
+    //! latte plasmoid -> method signature -> child items that provide that method
+    QHash<Plasma::Applet *, QHash<QByteArray, QList<MethodTarget>>> m_methodTargets;
 };
 
 }
@@ -28,13 +28,18 @@
 #include "../view/view.h"
 
 // Qt
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QTimer>
 
 // KDE
 #include <KConfigGroup>
+#include <KDirWatch>
 #include <KPluginMetaData>
 #include <KSharedConfig>
 #include <KPackage/Package>
@@ -51,6 +56,12 @@ namespace Layouts {
 const int Storage::IDNULL = -1;
 const int Storage::IDBASE = 0;
 
+#define PLASMOIDSROOT "plasma/plasmoids"
+#define METADATACACHEFILE "lattedock/appletsmetadata"
+//! cache misses that occur close to each other are written to disk together
+#define METADATASYNCINTERVAL 2000
+#define LAYOUTSINDEXFILE "lattedock/layoutsindex"
+
 Storage::Storage()
 {
     qDebug() << " >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> LAYOUTS::STORAGE, TEMP DIR ::: " << m_storageTmpDir.path();
@@ -61,10 +72,14 @@ Storage::Storage()
     m_subIdentities << SubContaimentIdentityData{.cfgGroup="Configuration", .cfgProperty="SystrayContainmentId"};
     //! Group applet
     m_subIdentities << SubContaimentIdentityData{.cfgGroup="Configuration", .cfgProperty="ContainmentId"};
+
+    initMetadataCache();
+    initLayoutsIndex();
 }
 
 Storage::~Storage()
 {
+    syncMetadata();
 }
 
 Storage *Storage::self()
@@ -225,20 +240,41 @@ void Storage::importToCorona(const Layout::GenericLayout *layout)
         return;
     }
 
+    IdsReservation reservation;
+    reservation.ids << layout->corona()->containmentsIds();
+    reservation.ids << layout->corona()->appletsIds();
+
+    bool updateLayoutId = (layout->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts);
+
+    importToCorona(layout, prepareImport(layout->file(), layout->name(), updateLayoutId, &reservation));
+}
+
+void Storage::importToCorona(const Layout::GenericLayout *layout, const QString &preparedFile)
+{
+    if (!layout->corona() || preparedFile.isEmpty()) {
+        return;
+    }
+
     //! Setting mutable for create a containment
     layout->corona()->setImmutability(Plasma::Types::Mutable);
 
-    QString temp1FilePath = m_storageTmpDir.path() +  "/" + layout->name() + ".multiple.views";
+    //! Finally import the configuration
+    importLayoutFile(layout, preparedFile);
+}
+
+QString Storage::prepareImport(const QString &layoutFile, const QString &layoutName, bool updateLayoutId, IdsReservation *reservation)
+{
+    QString temp1FilePath = m_storageTmpDir.path() +  "/" + layoutName + ".multiple.views";
     //! we need to copy first the layout file because the kde cache
     //! may not have yet been updated (KSharedConfigPtr)
     //! this way we make sure at the latest changes stored in the layout file
     //! will be also available when changing to Multiple Layouts
-    QString tempLayoutFilePath = m_storageTmpDir.path() +  "/" + layout->name() + ".multiple.tmplayout";
+    QString tempLayoutFilePath = m_storageTmpDir.path() +  "/" + layoutName + ".multiple.tmplayout";
 
     //! WE NEED A WAY TO COPY A CONTAINMENT!!!!
     QFile tempLayoutFile(tempLayoutFilePath);
     QFile copyFile(temp1FilePath);
-    QFile layoutOriginalFile(layout->file());
+    QFile layoutOriginalFile(layoutFile);
 
     if (tempLayoutFile.exists()) {
         tempLayoutFile.remove();
@@ -249,23 +285,21 @@ void Storage::importToCorona(const Layout::GenericLayout *layout)
 
     layoutOriginalFile.copy(tempLayoutFilePath);
 
-    KSharedConfigPtr filePtr = KSharedConfig::openConfig(tempLayoutFilePath);
-    KSharedConfigPtr newFile = KSharedConfig::openConfig(temp1FilePath);
-    KConfigGroup copyGroup = KConfigGroup(newFile, "Containments");
-    KConfigGroup current_containments = KConfigGroup(filePtr, "Containments");
+    //! KSharedConfig instances are thread local, plain KConfig is used in order
+    //! to be safe when layouts are prepared from worker threads
+    KConfig fileConfig(tempLayoutFilePath, KConfig::SimpleConfig);
+    KConfig newFileConfig(temp1FilePath, KConfig::SimpleConfig);
+    KConfigGroup copyGroup = KConfigGroup(&newFileConfig, "Containments");
+    KConfigGroup current_containments = KConfigGroup(&fileConfig, "Containments");
 
     current_containments.copyTo(&copyGroup);
 
     copyGroup.sync();
 
     //! update ids to unique ones
-    QString temp2File = newUniqueIdsLayoutFromFile(layout, temp1FilePath);
-
-    //! Finally import the configuration
-    importLayoutFile(layout, temp2File);
+    return newUniqueIdsFile(temp1FilePath, layoutName, updateLayoutId, reservation);
 }
 
-
 QString Storage::availableId(QStringList all, QStringList assigned, int base)
 {
     bool found = false;
@@ -300,7 +334,21 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
         return QString();
     }
 
-    QString tempFile = m_storageTmpDir.path() + "/" + layout->name() + ".views.newids";
+    //! pending changes of the provided file must be found on disk
+    KSharedConfig::openConfig(file)->sync();
+
+    IdsReservation reservation;
+    reservation.ids << layout->corona()->containmentsIds();
+    reservation.ids << layout->corona()->appletsIds();
+
+    bool updateLayoutId = (layout->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts);
+
+    return newUniqueIdsFile(file, layout->name(), updateLayoutId, &reservation);
+}
+
+QString Storage::newUniqueIdsFile(const QString &file, const QString &layoutName, bool updateLayoutId, IdsReservation *reservation)
+{
+    QString tempFile = m_storageTmpDir.path() + "/" + layoutName + ".views.newids";
 
     QFile copyFile(tempFile);
 
@@ -309,10 +357,6 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
     }
 
     //! BEGIN updating the ids in the temp file
-    QStringList allIds;
-    allIds << layout->corona()->containmentsIds();
-    allIds << layout->corona()->appletsIds();
-
     QStringList toInvestigateContainmentIds;
     QStringList toInvestigateAppletIds;
     QStringList toInvestigateSubContIds;
@@ -329,8 +373,8 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
     QStringList assignedIds;
     QHash<QString, QString> assigned;
 
-    KSharedConfigPtr filePtr = KSharedConfig::openConfig(file);
-    KConfigGroup investigate_conts = KConfigGroup(filePtr, "Containments");
+    KConfig fileConfig(file, KConfig::SimpleConfig);
+    KConfigGroup investigate_conts = KConfigGroup(&fileConfig, "Containments");
 
     //! Record the containment and applet ids
     for (const auto &cId : investigate_conts.groupList()) {
@@ -353,22 +397,28 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
         }
     }
 
-    //! Reassign containment and applet ids to unique ones
+    //! Reassign containment and applet ids to unique ones, layouts that are
+    //! prepared concurrently must not be assigned the same ids
+    QMutexLocker reservationLocker(&reservation->mutex);
+
     for (const auto &contId : toInvestigateContainmentIds) {
-        QString newId = availableId(allIds, assignedIds, 12);
+        QString newId = availableId(reservation->ids, assignedIds, 12);
 
         assignedIds << newId;
         assigned[contId] = newId;
     }
 
     for (const auto &appId : toInvestigateAppletIds) {
-        QString newId = availableId(allIds, assignedIds, 40);
+        QString newId = availableId(reservation->ids, assignedIds, 40);
 
         assignedIds << newId;
         assigned[appId] = newId;
     }
 
-    qDebug() << "ALL CORONA IDS ::: " << allIds;
+    qDebug() << "ALL RESERVED IDS ::: " << reservation->ids;
+
+    reservation->ids << assignedIds;
+    reservationLocker.unlock();
     qDebug() << "FULL ASSIGNMENTS ::: " << assigned;
 
     for (const auto &cId : toInvestigateContainmentIds) {
@@ -424,8 +474,8 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
             }
         }
 
-        if (layout->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
-            investigate_conts.group(cId).writeEntry("layoutId", layout->name());
+        if (updateLayoutId) {
+            investigate_conts.group(cId).writeEntry("layoutId", layoutName);
         }
     }
 
@@ -451,8 +501,8 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
     investigate_conts.sync();
 
     //! Copy To Temp 2 File And Update Correctly The Ids
-    KSharedConfigPtr file2Ptr = KSharedConfig::openConfig(tempFile);
-    KConfigGroup fixedNewContainmets = KConfigGroup(file2Ptr, "Containments");
+    KConfig file2Config(tempFile, KConfig::SimpleConfig);
+    KConfigGroup fixedNewContainmets = KConfigGroup(&file2Config, "Containments");
 
     for (const auto &contId : investigate_conts.groupList()) {
         QString pluginId = investigate_conts.group(contId).readEntry("plugin", "");
@@ -680,145 +730,493 @@ bool Storage::isBroken(const Layout::GenericLayout *layout, QStringList &errors)
         return false;
     }
 
+    if (!layout->corona()) {
+        //! inactive layouts are checked through the layout files index
+        LayoutFileSummary summary = layoutFileSummary(layout->file());
+        errors << summary.errors;
+
+        if (summary.isBroken) {
+            qDebug() << "   ----   ERROR - BROKEN LAYOUT :: " << layout->name() << " ----";
+            qDebug() << "   --- storaged file : " << layout->file();
+
+            for (const auto &error : summary.errors) {
+                qDebug() << "Error: " << error;
+            }
+
+            qDebug() << "  -- - -- - -- - -- - - -- - - - - -- - - - - ";
+        }
+
+        return summary.isBroken;
+    }
+
     QStringList ids;
     QStringList conts;
     QStringList applets;
 
-    KSharedConfigPtr lFile = KSharedConfig::openConfig(layout->file());
-
-    if (!layout->corona()) {
-        KConfigGroup containmentsEntries = KConfigGroup(lFile, "Containments");
-        ids << containmentsEntries.groupList();
-        conts << ids;
+    for (const auto containment : *layout->containments()) {
+        ids << QString::number(containment->id());
+        conts << QString::number(containment->id());
 
-        for (const auto &cId : containmentsEntries.groupList()) {
-            auto appletsEntries = containmentsEntries.group(cId).group("Applets");
+        for (const auto applet : containment->applets()) {
+            ids << QString::number(applet->id());
+            applets << QString::number(applet->id());
+        }
+    }
 
-            QStringList validAppletIds;
-            bool updated{false};
+    QStringList idsErrors;
 
-            for (const auto &appletId : appletsEntries.groupList()) {
-                KConfigGroup appletGroup = appletsEntries.group(appletId);
+    if (hasDuplicatedIds(ids, conts, applets, idsErrors)) {
+        qDebug() << "   ----   ERROR - BROKEN LAYOUT :: " << layout->name() << " ----";
 
-                if (Layouts::Storage::appletGroupIsValid(appletGroup)) {
-                    validAppletIds << appletId;
-                } else {
-                    updated = true;
-                    //! heal layout file by removing applet config records that are not used any more
-                    qDebug() << "Layout: " << layout->name() << " removing deprecated applet : " << appletId;
-                    appletsEntries.deleteGroup(appletId);
-                }
-            }
+        if (layout->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
+            qDebug() << "   --- in multiple layouts hidden file : " << Layouts::Importer::layoutUserFilePath(Layout::MULTIPLELAYOUTSHIDDENNAME);
+        } else {
+            qDebug() << "   --- in active layout file : " << layout->file();
+        }
 
-            if (updated) {
-                appletsEntries.sync();
-            }
+        qDebug() << "Containments :: " << conts;
+        qDebug() << "Applets :: " << applets;
 
-            ids << validAppletIds;
-            applets << validAppletIds;
+        for (const auto &error : idsErrors) {
+            qDebug() << "Error: " << error;
         }
-    } else {
+
+        errors << idsErrors;
+
+        qDebug() << "  -- - -- - -- - -- - - -- - - - - -- - - - - ";
+
         for (const auto containment : *layout->containments()) {
-            ids << QString::number(containment->id());
-            conts << QString::number(containment->id());
+            QStringList appletsIds;
 
             for (const auto applet : containment->applets()) {
-                ids << QString::number(applet->id());
-                applets << QString::number(applet->id());
+                appletsIds << QString::number(applet->id());
             }
+
+            qDebug() << " CONTAINMENT : " << containment->id() << " APPLETS : " << appletsIds.join(",");
         }
+
+        return true;
     }
 
+    return false;
+}
+
+bool Storage::hasDuplicatedIds(const QStringList &ids, const QStringList &conts, const QStringList &applets, QStringList &errors) const
+{
 #if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
     QSet<QString> idsSet = QSet<QString>::fromList(ids);
 #else
     QSet<QString> idsSet(ids.begin(), ids.end());
 #endif
-    /* a different way to count duplicates
-    QMap<QString, int> countOfStrings;
 
-    for (int i = 0; i < ids.count(); i++) {
-        countOfStrings[ids[i]]++;
-    }*/
+    if (idsSet.count() == ids.count()) {
+        return false;
+    }
 
-    if (idsSet.count() != ids.count()) {
-        qDebug() << "   ----   ERROR - BROKEN LAYOUT :: " << layout->name() << " ----";
+    for (const QString &c : conts) {
+        if (applets.contains(c)) {
+            errors << i18n("Same applet and containment id found ::: ") + c;
+        }
+    }
 
-        if (!layout->corona()) {
-            qDebug() << "   --- storaged file : " << layout->file();
-        } else {
-            if (layout->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
-                qDebug() << "   --- in multiple layouts hidden file : " << Layouts::Importer::layoutUserFilePath(Layout::MULTIPLELAYOUTSHIDDENNAME);
-            } else {
-                qDebug() << "   --- in active layout file : " << layout->file();
+    for (int i = 0; i < ids.count(); ++i) {
+        for (int j = i + 1; j < ids.count(); ++j) {
+            if (ids[i] == ids[j]) {
+                errors << i18n("Different applets with same id ::: ") + ids[i];
             }
         }
+    }
 
-        qDebug() << "Containments :: " << conts;
-        qDebug() << "Applets :: " << applets;
+    return true;
+}
 
-        for (const QString &c : conts) {
-            if (applets.contains(c)) {
-                QString errorStr = i18n("Same applet and containment id found ::: ") + c;
-                qDebug() << "Error: " << errorStr;
-                errors << errorStr;
-            }
+//! Layout Files Index
+void Storage::initLayoutsIndex()
+{
+    //! layout files are watched individually in order to drop only their own summaries
+    KDirWatch::self()->addDir(Layouts::Importer::layoutUserDir(), KDirWatch::WatchFiles);
+
+    QObject::connect(KDirWatch::self(), &KDirWatch::dirty, [this](const QString &path) {
+        layoutsDirChanged(path);
+    });
+    QObject::connect(KDirWatch::self(), &KDirWatch::created, [this](const QString &path) {
+        layoutsDirChanged(path);
+    });
+    QObject::connect(KDirWatch::self(), &KDirWatch::deleted, [this](const QString &path) {
+        layoutsDirChanged(path);
+    });
+
+    const QString indexFile = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + LAYOUTSINDEXFILE;
+    QDir().mkpath(QFileInfo(indexFile).absolutePath());
+    m_layoutsIndexConfig = KSharedConfig::openConfig(indexFile, KConfig::SimpleConfig);
+
+    for (const auto &groupName : m_layoutsIndexConfig->groupList()) {
+        KConfigGroup fileGroup = m_layoutsIndexConfig->group(groupName);
+        QString file = fileGroup.readEntry("file", QString());
+
+        if (file.isEmpty() || !QFile(file).exists()) {
+            fileGroup.deleteGroup();
+            continue;
         }
 
-        for (int i = 0; i < ids.count(); ++i) {
-            for (int j = i + 1; j < ids.count(); ++j) {
-                if (ids[i] == ids[j]) {
-                    QString errorStr = i18n("Different applets with same id ::: ") + ids[i];
-                    qDebug() << "Error: " << errorStr;
-                    errors << errorStr;
-                }
+        LayoutFileSummary summary;
+        summary.lastModified = QDateTime::fromMSecsSinceEpoch(fileGroup.readEntry("lastModified", qint64(0)));
+        summary.size = fileGroup.readEntry("size", qint64(0));
+        summary.isBroken = fileGroup.readEntry("isBroken", false);
+        summary.errors = fileGroup.readEntry("errors", QStringList());
+        summary.viewsCount = fileGroup.readEntry("viewsCount", 0);
+        summary.screens = fileGroup.readEntry("screens", QList<int>());
+        summary.plugins = fileGroup.readEntry("plugins", QStringList());
+
+        m_layoutsIndex[file] = summary;
+    }
+
+    m_layoutsIndexConfig->sync();
+}
+
+void Storage::layoutsDirChanged(const QString &path)
+{
+    if (m_layoutsIndex.contains(path)) {
+        removeFromLayoutsIndex(path);
+    } else if (path == Layouts::Importer::layoutUserDir()) {
+        //! files were added or removed
+        for (const auto &file : m_layoutsIndex.keys()) {
+            if (!QFile(file).exists()) {
+                removeFromLayoutsIndex(file);
             }
         }
+    }
+}
 
-        qDebug() << "  -- - -- - -- - -- - - -- - - - - -- - - - - ";
+void Storage::removeFromLayoutsIndex(const QString &file) const
+{
+    m_layoutsIndex.remove(file);
+
+    const QString groupName = QCryptographicHash::hash(file.toUtf8(), QCryptographicHash::Md5).toHex();
+    m_layoutsIndexConfig->group(groupName).deleteGroup();
+    m_layoutsIndexConfig->sync();
+}
+
+void Storage::saveToLayoutsIndex(const QString &file, const LayoutFileSummary &summary) const
+{
+    m_layoutsIndex[file] = summary;
+
+    const QString groupName = QCryptographicHash::hash(file.toUtf8(), QCryptographicHash::Md5).toHex();
+    KConfigGroup fileGroup = m_layoutsIndexConfig->group(groupName);
+
+    fileGroup.writeEntry("file", file);
+    fileGroup.writeEntry("lastModified", summary.lastModified.toMSecsSinceEpoch());
+    fileGroup.writeEntry("size", summary.size);
+    fileGroup.writeEntry("isBroken", summary.isBroken);
+    fileGroup.writeEntry("errors", summary.errors);
+    fileGroup.writeEntry("viewsCount", summary.viewsCount);
+    fileGroup.writeEntry("screens", summary.screens);
+    fileGroup.writeEntry("plugins", summary.plugins);
+
+    m_layoutsIndexConfig->sync();
+}
+
+LayoutFileSummary Storage::layoutFileSummary(const QString &file) const
+{
+    QFileInfo fileInfo(file);
+
+    if (file.isEmpty() || !fileInfo.exists()) {
+        if (m_layoutsIndex.contains(file)) {
+            removeFromLayoutsIndex(file);
+        }
+
+        return LayoutFileSummary();
+    }
+
+    if (m_layoutsIndex.contains(file)) {
+        const LayoutFileSummary &summary = m_layoutsIndex[file];
+
+        if (summary.lastModified == fileInfo.lastModified() && summary.size == fileInfo.size()) {
+            return summary;
+        }
+    }
+
+    LayoutFileSummary summary = indexLayoutFile(file);
+    saveToLayoutsIndex(file, summary);
+
+    return summary;
+}
+
+LayoutFileSummary Storage::indexLayoutFile(const QString &file) const
+{
+    LayoutFileSummary summary;
+
+    QStringList ids;
+    QStringList conts;
+    QStringList applets;
+
+    KSharedConfigPtr lFile = KSharedConfig::openConfig(file);
+    KConfigGroup containmentsEntries = KConfigGroup(lFile, "Containments");
+
+    for (const auto &cId : containmentsEntries.groupList()) {
+        KConfigGroup containmentGroup = containmentsEntries.group(cId);
 
-        if (!layout->corona()) {
-            KConfigGroup containmentsEntries = KConfigGroup(lFile, "Containments");
+        ids << cId;
+        conts << cId;
 
-            for (const auto &cId : containmentsEntries.groupList()) {
-                auto appletsEntries = containmentsEntries.group(cId).group("Applets");
+        if (isLatteContainment(containmentGroup)) {
+            summary.viewsCount++;
 
-                qDebug() << " CONTAINMENT : " << cId << " APPLETS : " << appletsEntries.groupList();
+            int screenId = containmentGroup.readEntry("lastScreen", IDNULL);
+
+            if (isValid(screenId) && !summary.screens.contains(screenId)) {
+                summary.screens << screenId;
             }
-        } else {
-            for (const auto containment : *layout->containments()) {
-                QStringList appletsIds;
+        }
 
-                for (const auto applet : containment->applets()) {
-                    appletsIds << QString::number(applet->id());
-                }
+        auto appletsEntries = containmentGroup.group("Applets");
 
-                qDebug() << " CONTAINMENT : " << containment->id() << " APPLETS : " << appletsIds.join(",");
+        QStringList validAppletIds;
+        bool updated{false};
+
+        for (const auto &appletId : appletsEntries.groupList()) {
+            KConfigGroup appletGroup = appletsEntries.group(appletId);
+
+            if (Layouts::Storage::appletGroupIsValid(appletGroup)) {
+                validAppletIds << appletId;
+
+                if (!isSubContainment(appletGroup)) {
+                    QString pluginId = appletGroup.readEntry("plugin", "");
+
+                    if (!summary.plugins.contains(pluginId)) {
+                        summary.plugins << pluginId;
+                    }
+                }
+            } else {
+                updated = true;
+                //! heal layout file by removing applet config records that are not used any more
+                qDebug() << "Layout file: " << file << " removing deprecated applet : " << appletId;
+                appletsEntries.deleteGroup(appletId);
             }
         }
 
-        return true;
+        if (updated) {
+            appletsEntries.sync();
+        }
+
+        ids << validAppletIds;
+        applets << validAppletIds;
     }
 
-    return false;
+    summary.isBroken = hasDuplicatedIds(ids, conts, applets, summary.errors);
+
+    //! file info is read after healing in order to index the final file
+    QFileInfo fileInfo(file);
+    summary.lastModified = fileInfo.lastModified();
+    summary.size = fileInfo.size();
+
+    return summary;
 }
 
 //! AppletsData Information
+void Storage::initMetadataCache()
+{
+    const QString localRoot = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QLatin1Char('/') + PLASMOIDSROOT;
+
+    m_packageRoots << localRoot;
+
+    for (const auto &root : QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, PLASMOIDSROOT, QStandardPaths::LocateDirectory)) {
+        if (!m_packageRoots.contains(root)) {
+            m_packageRoots << root;
+        }
+    }
+
+    //! plasmoids are installed or removed as whole directories in their roots, while
+    //! updates in place are tracked from the metadata file of each cached plasmoid
+    for (const auto &root : m_packageRoots) {
+        KDirWatch::self()->addDir(root);
+    }
+
+    QObject::connect(KDirWatch::self(), &KDirWatch::dirty, [this](const QString &path) {
+        packageRootChanged(path);
+    });
+    QObject::connect(KDirWatch::self(), &KDirWatch::created, [this](const QString &path) {
+        packageRootChanged(path);
+    });
+    QObject::connect(KDirWatch::self(), &KDirWatch::deleted, [this](const QString &path) {
+        packageRootChanged(path);
+    });
+
+    const QString cacheFile = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + METADATACACHEFILE;
+    QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+    m_metadataConfig = KSharedConfig::openConfig(cacheFile, KConfig::SimpleConfig);
+
+    KConfigGroup generalGroup = m_metadataConfig->group("General");
+    KConfigGroup appletsGroup = m_metadataConfig->group("Applets");
+
+    if (generalGroup.readEntry("signature", QString()) != packageRootsSignature()) {
+        //! plasmoids were installed or removed since the cache was written
+        appletsGroup.deleteGroup();
+        generalGroup.writeEntry("signature", packageRootsSignature());
+        m_metadataConfig->sync();
+        return;
+    }
+
+    bool updated{false};
+
+    for (const auto &pluginId : appletsGroup.groupList()) {
+        KConfigGroup pluginGroup = appletsGroup.group(pluginId);
+        QString metadataFile = pluginGroup.readEntry("metadataFile", QString());
+
+        //! plasmoids that were updated in place since the cache was written
+        if (metadataFile.isEmpty() || metadataFileModified(metadataFile) != pluginGroup.readEntry("lastModified", qint64(0))) {
+            pluginGroup.deleteGroup();
+            updated = true;
+            continue;
+        }
+
+        Data::Applet data;
+        data.id = pluginId;
+        data.name = pluginGroup.readEntry("name", QString());
+        data.description = pluginGroup.readEntry("description", QString());
+        data.icon = pluginGroup.readEntry("icon", QString());
+
+        m_metadata[pluginId] = data;
+        watchMetadataFile(pluginId, metadataFile);
+    }
+
+    if (updated) {
+        m_metadataConfig->sync();
+    }
+}
+
+QString Storage::packageRootsSignature() const
+{
+    QStringList signature;
+
+    for (const auto &root : m_packageRoots) {
+        QFileInfo rootInfo(root);
+        signature << root + QLatin1Char(':') + QString::number(rootInfo.exists() ? rootInfo.lastModified().toMSecsSinceEpoch() : 0);
+    }
+
+    return signature.join(QLatin1Char(';'));
+}
+
+qint64 Storage::metadataFileModified(const QString &metadataFile) const
+{
+    QFileInfo metadataInfo(metadataFile);
+    return metadataInfo.exists() ? metadataInfo.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+void Storage::watchMetadataFile(const QString &pluginId, const QString &metadataFile)
+{
+    if (metadataFile.isEmpty() || m_metadataFiles.contains(metadataFile)) {
+        return;
+    }
+
+    m_metadataFiles[metadataFile] = pluginId;
+    KDirWatch::self()->addFile(metadataFile);
+}
+
+void Storage::clearMetadataFiles()
+{
+    for (const auto &metadataFile : m_metadataFiles.keys()) {
+        KDirWatch::self()->removeFile(metadataFile);
+    }
+
+    m_metadataFiles.clear();
+}
+
+void Storage::scheduleMetadataSync()
+{
+    if (m_metadataSyncScheduled) {
+        return;
+    }
+
+    //! plasmoids are usually requested in bursts when layouts are loaded
+    m_metadataSyncScheduled = true;
+
+    QTimer::singleShot(METADATASYNCINTERVAL, [this]() {
+        syncMetadata();
+    });
+}
+
+void Storage::syncMetadata()
+{
+    if (!m_metadataSyncScheduled) {
+        return;
+    }
+
+    m_metadataSyncScheduled = false;
+    m_metadataConfig->sync();
+}
+
+void Storage::packageRootChanged(const QString &path)
+{
+    if (m_metadataFiles.contains(path)) {
+        //! a plasmoid was updated in place, only its own metadata are dropped
+        const QString pluginId = m_metadataFiles.take(path);
+        KDirWatch::self()->removeFile(path);
+
+        qDebug() << "Plasmoid was changed, applet metadata are cleared for :: " << pluginId;
+
+        m_metadata.remove(pluginId);
+        m_metadataConfig->group("Applets").deleteGroup(pluginId);
+        scheduleMetadataSync();
+        return;
+    }
+
+    bool isPackageRoot{false};
+
+    for (const auto &root : m_packageRoots) {
+        if (path == root || path.startsWith(root + QLatin1Char('/'))) {
+            isPackageRoot = true;
+            break;
+        }
+    }
+
+    if (!isPackageRoot || m_metadata.isEmpty()) {
+        return;
+    }
+
+    qDebug() << "Plasmoids were changed, applets metadata cache is cleared...";
+
+    m_metadata.clear();
+    clearMetadataFiles();
+
+    m_metadataConfig->group("Applets").deleteGroup();
+    m_metadataConfig->group("General").writeEntry("signature", packageRootsSignature());
+    scheduleMetadataSync();
+}
+
 Data::Applet Storage::metadata(const QString &pluginId)
 {
+    if (m_metadata.contains(pluginId)) {
+        return m_metadata[pluginId];
+    }
+
     Data::Applet data;
     data.id = pluginId;
 
     KPackage::Package pkg = KPackage::PackageLoader::self()->loadPackage(QStringLiteral("Plasma/Applet"));
-    pkg.setDefaultPackageRoot(QStringLiteral("plasma/plasmoids"));
+    pkg.setDefaultPackageRoot(QStringLiteral(PLASMOIDSROOT));
     pkg.setPath(pluginId);
 
+    QString metadataFile;
+
     if (pkg.isValid()) {
         data.name = pkg.metadata().name();
         data.description = pkg.metadata().description();
         data.icon = pkg.metadata().iconName();
+        metadataFile = pkg.metadata().metaDataFileName();
     }
 
+    m_metadata[pluginId] = data;
+    watchMetadataFile(pluginId, metadataFile);
+
+    KConfigGroup pluginGroup = m_metadataConfig->group("Applets").group(pluginId);
+    pluginGroup.writeEntry("name", data.name);
+    pluginGroup.writeEntry("description", data.description);
+    pluginGroup.writeEntry("icon", data.icon);
+    pluginGroup.writeEntry("metadataFile", metadataFile);
+    pluginGroup.writeEntry("lastModified", metadataFileModified(metadataFile));
+    scheduleMetadataSync();
+
     return data;
 }
 
@@ -889,6 +1287,25 @@ Data::AppletsTable Storage::plugins(const QString &layoutfile, const int contain
         return knownapplets;
     }
 
+    if (!isValid(containmentid)) {
+        //! plugins of all containments are found in the layout files index
+        for (const auto &pluginId : layoutFileSummary(layoutfile).plugins) {
+            if (!knownapplets.containsId(pluginId) && !unknownapplets.containsId(pluginId)) {
+                Data::Applet appletdata = metadata(pluginId);
+
+                if (appletdata.isValid()) {
+                    knownapplets.insertBasedOnName(appletdata);
+                } else {
+                    unknownapplets.insertBasedOnId(appletdata);
+                }
+            }
+        }
+
+        knownapplets << unknownapplets;
+
+        return knownapplets;
+    }
+
     KSharedConfigPtr lFile = KSharedConfig::openConfig(layoutfile);
     KConfigGroup containmentGroups = KConfigGroup(lFile, "Containments");
 
@@ -1023,23 +1440,7 @@ QList<Layout::ViewData> Storage::viewsData(const QString &file, const QHash<int,
 
 QList<int> Storage::viewsScreens(const QString &file)
 {
-    QList<int> screens;
-
-    KSharedConfigPtr lFile = KSharedConfig::openConfig(file);
-
-    KConfigGroup containmentGroups = KConfigGroup(lFile, "Containments");
-
-    for (const auto &cId : containmentGroups.groupList()) {
-        if (Layouts::Storage::self()->isLatteContainment(containmentGroups.group(cId))) {
-            int screenId = containmentGroups.group(cId).readEntry("lastScreen", IDNULL);
-
-            if (isValid(screenId) && !screens.contains(screenId)) {
-                screens << screenId;
-            }
-        }
-    }
-
-    return screens;
+    return layoutFileSummary(file).screens;
 }
 
 }
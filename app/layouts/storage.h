@@ -24,10 +24,14 @@
 #include "../data/appletdata.h"
 
 // Qt
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
 #include <QTemporaryDir>
 
 // KDE
 #include <KConfigGroup>
+#include <KSharedConfig>
 
 // Plasma
 #include <Plasma/Applet>
@@ -57,6 +61,27 @@ struct ViewDelayedCreationData
     bool reactToScreenChange{false};
 };
 
+//! Ids that are already used or assigned while layouts are prepared
+//! concurrently for importing, it is shared between the worker threads
+struct IdsReservation
+{
+    QMutex mutex;
+    QStringList ids;
+};
+
+//! Summary of a layout file, it is indexed in order to not parse
+//! again layout files that have not changed
+struct LayoutFileSummary
+{
+    QDateTime lastModified;
+    qint64 size{0};
+    bool isBroken{false};
+    QStringList errors;
+    int viewsCount{0};
+    QList<int> screens;
+    QStringList plugins;
+};
+
 class Storage
 {
 
@@ -81,6 +106,11 @@ public:
     void unlock(const Layout::GenericLayout *layout); //! make it writable which it should be the default
 
     void importToCorona(const Layout::GenericLayout *layout);
+    //! imports a layout file that was already prepared with prepareImport()
+    void importToCorona(const Layout::GenericLayout *layout, const QString &preparedFile);
+    //! copies the layout containments to a temporary file with unique ids and returns
+    //! that file. It does not touch corona, so it can be used from worker threads
+    QString prepareImport(const QString &layoutFile, const QString &layoutName, bool updateLayoutId, IdsReservation *reservation);
     void syncToLayoutFile(const Layout::GenericLayout *layout, bool removeLayoutId);
     ViewDelayedCreationData copyView(const Layout::GenericLayout *layout, Plasma::Containment *containment);
 
@@ -104,6 +134,9 @@ public:
     //! list<ViewData>
     QList<Layout::ViewData> viewsData(const QString &file, const QHash<int, QList<int>> &subContainments);
 
+    //! Layout Files Index
+    LayoutFileSummary layoutFileSummary(const QString &file) const;
+
 private:
     Storage();
 
@@ -116,13 +149,52 @@ private:
     //! has updated ids for containments and applets based on the corona
     //! loaded ones
     QString newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout, QString file);
+    QString newUniqueIdsFile(const QString &file, const QString &layoutName, bool updateLayoutId, IdsReservation *reservation);
     //! imports a layout file and returns the containments for the docks
     QList<Plasma::Containment *> importLayoutFile(const Layout::GenericLayout *layout, QString file);
 
+    //! APPLETS METADATA CACHE !////
+    //! metadata are cached in memory and on disk, they are invalidated when
+    //! plasmoids are installed or removed from the plasmoids roots and when the
+    //! metadata file of a cached plasmoid is updated
+    QString packageRootsSignature() const;
+    qint64 metadataFileModified(const QString &metadataFile) const;
+    void initMetadataCache();
+    void packageRootChanged(const QString &path);
+    void watchMetadataFile(const QString &pluginId, const QString &metadataFile);
+    void clearMetadataFiles();
+    void scheduleMetadataSync();
+    void syncMetadata();
+
+    //! LAYOUT FILES INDEX !////
+    //! summaries of layout files are cached in memory and on disk, each one is
+    //! invalidated when its file modification time or size changes and it is
+    //! dropped when the layouts directory watcher reports its file as changed
+    void initLayoutsIndex();
+    void layoutsDirChanged(const QString &path);
+    void removeFromLayoutsIndex(const QString &file) const;
+    void saveToLayoutsIndex(const QString &file, const LayoutFileSummary &summary) const;
+    LayoutFileSummary indexLayoutFile(const QString &file) const;
+
+    //! checks ids for duplicates and reports the found errors
+    bool hasDuplicatedIds(const QStringList &ids, const QStringList &conts, const QStringList &applets, QStringList &errors) const;
+
 private:
     QTemporaryDir m_storageTmpDir;
 
     QList<SubContaimentIdentityData> m_subIdentities;
+
+    QStringList m_packageRoots;
+    //! pluginId, applet metadata
+    QHash<QString, Data::Applet> m_metadata;
+    //! metadata file, pluginId
+    QHash<QString, QString> m_metadataFiles;
+    KSharedConfig::Ptr m_metadataConfig;
+    bool m_metadataSyncScheduled{false};
+
+    //! layout file, layout file summary
+    mutable QHash<QString, LayoutFileSummary> m_layoutsIndex;
+    KSharedConfig::Ptr m_layoutsIndexConfig;
 };
 
 }
@@ -22,6 +22,7 @@
 //! local
 #include "importer.h"
 #include "manager.h"
+#include "storage.h"
 #include "../apptypes.h"
 #include "../data/layoutdata.h"
 #include "../lattecorona.h"
@@ -34,6 +35,7 @@
 // Qt
 #include <QDir>
 #include <QFile>
+#include <QtConcurrent>
 
 // Plasma
 #include <Plasma/Containment>
@@ -268,10 +270,11 @@ void Synchronizer::updateLayoutsTable()
         }
     }
 
+    //! inactive layouts are checked through the layout files index, only
+    //! the files that changed since their last check are parsed again
     for (int i = 0; i < m_layouts.rowCount(); ++i) {
         if (m_layouts[i].isBroken && !m_layouts[i].isActive) {
-            CentralLayout central(this, m_layouts[i].id);
-            m_layouts[i].isBroken = central.isBroken();
+            m_layouts[i].isBroken = Layouts::Storage::self()->layoutFileSummary(m_layouts[i].id).isBroken;
         }
     }
 }
@@ -879,6 +882,7 @@ void Synchronizer::syncMultipleLayoutsToActivities()
     }
 
     QStringList newlyActivatedLayouts;
+    QList<CentralLayout *> newLayouts;
 
     //! Add needed Layouts based on Activities settings
     for (const auto &layoutname : layoutNamesToLoad) {
@@ -888,15 +892,35 @@ void Synchronizer::syncMultipleLayoutsToActivities()
             if (newLayout) {
                 qDebug() << "ACTIVATING LAYOUT ::::: " << layoutname;
                 addLayout(newLayout);
-                newLayout->importToCorona();
+                newLayouts << newLayout;
+            }
+        }
+    }
 
-                if (!defaultForcedLayout.isEmpty() && defaultForcedLayout == layoutname) {
-                    emit newLayoutAdded(newLayout->data());
-                }
+    //! layout files are copied and their ids are updated concurrently in worker
+    //! threads, only their containments are instantiated in the gui thread
+    Layouts::IdsReservation reservation;
+    reservation.ids << m_manager->corona()->containmentsIds();
+    reservation.ids << m_manager->corona()->appletsIds();
 
-                newlyActivatedLayouts << newLayout->name();
-            }
+    bool updateLayoutId = (m_manager->memoryUsage() == MemoryUsage::MultipleLayouts);
+    QList<QFuture<QString>> preparedFiles;
+
+    for (const auto newLayout : newLayouts) {
+        preparedFiles << QtConcurrent::run(Layouts::Storage::self(), &Layouts::Storage::prepareImport,
+                                           newLayout->file(), newLayout->name(), updateLayoutId, &reservation);
+    }
+
+    for (int i = 0; i < newLayouts.count(); ++i) {
+        CentralLayout *newLayout = newLayouts[i];
+
+        Layouts::Storage::self()->importToCorona(newLayout, preparedFiles[i].result());
+
+        if (!defaultForcedLayout.isEmpty() && defaultForcedLayout == newLayout->name()) {
+            emit newLayoutAdded(newLayout->data());
         }
+
+        newlyActivatedLayouts << newLayout->name();
     }
 
     if (m_manager->corona()->universalSettings()->showInfoWindow()) {
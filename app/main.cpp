@@ -169,6 +169,11 @@ int main(int argc, char **argv)
     filterDebugInputMask.setDescription(QStringLiteral("Show visual window indicators for calculated input mask."));
     filterDebugInputMask.setFlags(QCommandLineOption::HiddenFromHelp);
     parser.addOption(filterDebugInputMask);
+
+    QCommandLineOption sharedIndicatorsOption(QStringList() << QStringLiteral("shared-indicators"));
+    sharedIndicatorsOption.setDescription(QStringLiteral("Share the compiled indicators between all docks and panels (experimental)."));
+    sharedIndicatorsOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(sharedIndicatorsOption);
     //! END: Hidden options
 
     parser.process(app);
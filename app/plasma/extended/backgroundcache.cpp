@@ -23,11 +23,17 @@
 #include "../../tools/commontools.h"
 
 // Qt
+#include <QCryptographicHash>
 #include <QDebug>
+#include <QDir>
 #include <QFileInfo>
 #include <QImage>
+#include <QImageReader>
 #include <QList>
 #include <QRgb>
+#include <QStandardPaths>
+#include <QVector>
+#include <QtConcurrent>
 #include <QtMath>
 
 // Plasma
@@ -38,6 +44,13 @@
 #include <KDirWatch>
 
 #define MAXHASHSIZE 300
+#define MAXDISKHASHSIZE 1000
+
+//! wallpapers bigger than that are decoded directly at a smaller size,
+//! the edges hints are approximating what is shown under the views
+#define MAXDECODEDLENGTH 1920
+
+#define HINTSCACHEFILE "lattedock/backgroundhints"
 
 #define PLASMACONFIG "plasma-org.kde.plasma.desktop-appletsrc"
 #define DEFAULTWALLPAPER "wallpapers/Next/contents/images/1920x1080.png"
@@ -56,6 +69,10 @@ BackgroundCache::BackgroundCache(QObject *parent)
 
     m_defaultWallpaperPath = Latte::standardPath(DEFAULTWALLPAPER);
 
+    const auto hintsFile = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + HINTSCACHEFILE;
+    QDir().mkpath(QFileInfo(hintsFile).absolutePath());
+    m_hintsConfig = KSharedConfig::openConfig(hintsFile, KConfig::SimpleConfig);
+
     qDebug() << "Default Wallpaper path ::: " << m_defaultWallpaperPath;
 
     KDirWatch::self()->addFile(configFile);
@@ -71,7 +88,11 @@ BackgroundCache::BackgroundCache(QObject *parent)
 }
 
 BackgroundCache::~BackgroundCache()
-{   
+{
+    for (const auto watcher : m_pendingCalculations) {
+        watcher->waitForFinished();
+    }
+
     if (m_pool) {
         m_pool->deleteLater();
     }
@@ -197,6 +218,11 @@ QString BackgroundCache::background(QString activity, QString screen) const
     }
 }
 
+bool BackgroundCache::hintsArePendingFor(QString activity, QString screen) const
+{
+    return m_pendingCalculations.contains(background(activity, screen));
+}
+
 bool BackgroundCache::busyFor(QString activity, QString screen, Plasma::Types::Location location)
 {
     QString assignedBackground = background(activity, screen);
@@ -219,30 +245,7 @@ float BackgroundCache::brightnessFor(QString activity, QString screen, Plasma::T
     return -1000;
 }
 
-float BackgroundCache::brightnessFromArea(QImage &image, int firstRow, int firstColumn, int endRow, int endColumn)
-{
-    float areaBrightness = -1000;
-
-    if (image.format() != QImage::Format_Invalid) {
-        for (int row = firstRow; row < endRow; ++row) {
-            QRgb *line = (QRgb *)image.scanLine(row);
-
-            for (int col = firstColumn; col < endColumn ; ++col) {
-                QRgb pixelData = line[col];
-                float pixelBrightness = Latte::colorBrightness(pixelData);
-
-                areaBrightness = (areaBrightness == -1000) ? pixelBrightness : (areaBrightness + pixelBrightness);
-            }
-        }
-
-        float areaSize = (endRow - firstRow) * (endColumn - firstColumn);
-        areaBrightness = areaBrightness / areaSize;
-    }
-
-    return areaBrightness;
-}
-
-bool BackgroundCache::areaIsBusy(float bright1, float bright2) const
+bool BackgroundCache::areaIsBusy(float bright1, float bright2)
 {
     bool bright1IsLight = bright1>=123;
     bool bright2IsLight = bright2>=123;
@@ -254,132 +257,288 @@ bool BackgroundCache::areaIsBusy(float bright1, float bright2) const
 
 //! In order to calculate the brightness and busy hints for specific image
 //! the code is doing the following. It is not needed to calculate these values
-//! for the entire image that would also be cpu costly. The function takes
-//! the location of the area in the image for which we are interested.
-//! The area is split in ten different Tiles and for each one its brightness
-//! is computed. The brightness average from these tiles provides the entire
-//! area brightness. In order to indicate if this area is busy or not we
-//! compare the minimum and the maximum values of brightness from these
-//! tiles. If the difference it too big then the area is busy
-void BackgroundCache::updateImageCalculations(QString imageFile, Plasma::Types::Location location)
+//! for the entire image that would also be cpu costly. For each edge of the
+//! image only a 24px. strip is considered. Each strip is split in ten different
+//! Tiles and for each one its brightness is computed. The brightness average
+//! from these tiles provides the entire strip brightness. In order to indicate
+//! if this strip is busy or not we compare the minimum and the maximum values
+//! of brightness from these tiles. If the difference it too big then the strip
+//! is busy. All four edges are computed together with one pass over the image.
+//! The calculations are running in a worker thread, an empty result is returned
+//! for images that can not be decoded.
+EdgesHash BackgroundCache::imageCalculations(QString imageFile)
 {
-    if (m_hintsCache.size() > MAXHASHSIZE) {
-        cleanupHashes();
+    //! if it is a local image
+    QImageReader reader(imageFile);
+    QSize imageSize = reader.size();
+
+    if (imageSize.isValid() && (imageSize.width() > MAXDECODEDLENGTH || imageSize.height() > MAXDECODEDLENGTH)) {
+        //! decoders such as jpeg are much faster when they are scaling down during decoding
+        reader.setScaledSize(imageSize.scaled(MAXDECODEDLENGTH, MAXDECODEDLENGTH, Qt::KeepAspectRatio));
     }
 
-    //! if it is a local image
-    QImage image(imageFile);
+    QImage image = reader.read();
 
-    if (image.format() != QImage::Format_Invalid) {
-        float brightness{-1000};
-        float maxBrightness{0};
-        float minBrightness{255};
+    if (image.format() == QImage::Format_Invalid) {
+        return EdgesHash();
+    }
 
-        bool vertical = (location == Plasma::Types::LeftEdge || location == Plasma::Types::RightEdge) ? true : false;
-        int imageLength = !vertical ? image.width() : image.height();
-        int tiles{qMin(10,imageLength)};
+    //! pixels are read directly as QRgb values
+    if (image.format() != QImage::Format_RGB32
+            && image.format() != QImage::Format_ARGB32
+            && image.format() != QImage::Format_ARGB32_Premultiplied) {
+        image = image.convertToFormat(QImage::Format_RGB32);
+    }
 
-        //! 24px. should be enough because the views are always snapped to edges
-        int tileThickness = !vertical ? qMin(24,image.height()) : qMin(24,image.width());
-        int tileLength = imageLength / tiles ;
+    const int width = image.width();
+    const int height = image.height();
 
-        int tileWidth = !vertical ? tileLength : tileThickness;
-        int tileHeight = !vertical ? tileThickness : tileLength;
+    int horizontalTiles{qMin(10, width)};
+    int verticalTiles{qMin(10, height)};
 
-        float factor = ((float)100/tiles)/100;
+    //! 24px. should be enough because the views are always snapped to edges
+    int horizontalThickness = qMin(24, height);
+    int verticalThickness = qMin(24, width);
 
-        QList<float> subBrightness;
+    //! tiles boundaries, tile i is found at [bounds[i], bounds[i+1])
+    QVector<int> columnBounds(horizontalTiles + 1);
+    QVector<int> rowBounds(verticalTiles + 1);
 
-        qDebug() << "------------   -- Image Calculations --  --------------" ;
-        qDebug() << "Hints for Background image | " << imageFile;
-        qDebug() << "Hints for Background image | Edge: " << location << ", Image size: " << image.width() << "x" << image.height() << ", Tiles: " << tiles << ", subsize: " << tileWidth << "x" << tileHeight;
+    for (int i=0; i<=horizontalTiles; ++i) {
+        columnBounds[i] = (i * width) / horizontalTiles;
+    }
 
-        //! Iterating algorigthm
-        int firstRow = 0; int firstColumn = 0; int endRow = 0; int endColumn = 0;
+    for (int i=0; i<=verticalTiles; ++i) {
+        rowBounds[i] = (i * height) / verticalTiles;
+    }
 
-        //! horizontal tiles calculations
-        if (location == Plasma::Types::TopEdge) {
-            firstRow = 0; endRow = tileThickness;
-        } else if (location == Plasma::Types::BottomEdge) {
-            firstRow = image.height() - tileThickness - 1; endRow = image.height() - 1;
-        }
+    QVector<quint64> topSums(horizontalTiles, 0);
+    QVector<quint64> bottomSums(horizontalTiles, 0);
+    QVector<quint64> leftSums(verticalTiles, 0);
+    QVector<quint64> rightSums(verticalTiles, 0);
+
+    qDebug() << "------------   -- Image Calculations --  --------------" ;
+    qDebug() << "Hints for Background image | " << imageFile;
+    qDebug() << "Hints for Background image | Image size: " << width << "x" << height
+             << ", Tiles: " << horizontalTiles << "x" << verticalTiles << ", thickness: " << horizontalThickness << "x" << verticalThickness;
 
-        if (!vertical) {
-            for (int i=1; i<=tiles; ++i) {
-                float subFactor = ((float)i) * factor;
-                firstColumn = endColumn+1; endColumn = (subFactor*imageLength) - 1;
-                endColumn = qMin(endColumn, imageLength-1);
+    int verticalTile{0};
 
-                int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
-                qDebug() << " Tile considering horizontal << (" << firstColumn << "," << firstRow << ") - (" << endColumn << "," << endRow << "), subfactor: " << subFactor
-                         << ", brightness: " << tempBrightness;
+    for (int row = 0; row < height; ++row) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(row));
 
-                subBrightness.append(tempBrightness);
+        bool inTopStrip = (row < horizontalThickness);
+        bool inBottomStrip = (row >= height - horizontalThickness);
 
-                if (tempBrightness > maxBrightness) {
-                    maxBrightness = tempBrightness;
+        if (inTopStrip || inBottomStrip) {
+            for (int i=0; i<horizontalTiles; ++i) {
+                quint64 tileSum = colorsBrightnessSum(line + columnBounds[i], columnBounds[i+1] - columnBounds[i]);
+
+                if (inTopStrip) {
+                    topSums[i] += tileSum;
                 }
-                if (tempBrightness < minBrightness) {
-                    minBrightness = tempBrightness;
+
+                if (inBottomStrip) {
+                    bottomSums[i] += tileSum;
                 }
             }
         }
 
-        //! vertical tiles calculations
-        if (location == Plasma::Types::LeftEdge) {
-            firstColumn = 0; endColumn = tileThickness;
-        } else if (location == Plasma::Types::RightEdge) {
-            firstColumn = image.width() - 1 - tileThickness; endColumn = image.width() - 1;
+        while (row >= rowBounds[verticalTile + 1]) {
+            ++verticalTile;
         }
 
-        if (vertical) {
-            for (int i=1; i<=tiles; ++i) {
-                float subFactor = ((float)i) * factor;
-                firstRow = endRow+1; endRow = (subFactor*imageLength) - 1;
-                endRow = qMin(endRow, imageLength-1);
+        leftSums[verticalTile] += colorsBrightnessSum(line, verticalThickness);
+        rightSums[verticalTile] += colorsBrightnessSum(line + width - verticalThickness, verticalThickness);
+    }
 
-                int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
-                qDebug() << " Tile considering vertical << (" << firstColumn << "," << firstRow << ") - (" << endColumn << "," << endRow << "), subfactor: " << subFactor
-                         << ", brightness: " << tempBrightness;
+    QList<float> topBrightness;
+    QList<float> bottomBrightness;
+    QList<float> leftBrightness;
+    QList<float> rightBrightness;
 
-                subBrightness.append(tempBrightness);
+    for (int i=0; i<horizontalTiles; ++i) {
+        float tileArea = 1000.0f * (columnBounds[i+1] - columnBounds[i]) * horizontalThickness;
+        topBrightness << topSums[i] / tileArea;
+        bottomBrightness << bottomSums[i] / tileArea;
+    }
 
-                if (tempBrightness > maxBrightness) {
-                    maxBrightness = tempBrightness;
-                }
-                if (tempBrightness < minBrightness) {
-                    minBrightness = tempBrightness;
-                }
-            }
-        }
-        //! compute total brightness for this area
-        float subBrightnessSum = 0;
+    for (int i=0; i<verticalTiles; ++i) {
+        float tileArea = 1000.0f * (rowBounds[i+1] - rowBounds[i]) * verticalThickness;
+        leftBrightness << leftSums[i] / tileArea;
+        rightBrightness << rightSums[i] / tileArea;
+    }
 
-        for (int i=0; i<subBrightness.count(); ++i) {
-            subBrightnessSum = subBrightnessSum + subBrightness[i];
-        }
+    EdgesHash edges;
+    edges[Plasma::Types::TopEdge] = hintsFromTiles(topBrightness);
+    edges[Plasma::Types::BottomEdge] = hintsFromTiles(bottomBrightness);
+    edges[Plasma::Types::LeftEdge] = hintsFromTiles(leftBrightness);
+    edges[Plasma::Types::RightEdge] = hintsFromTiles(rightBrightness);
+
+    for (EdgesHash::const_iterator i=edges.constBegin(); i!=edges.constEnd(); ++i) {
+        qDebug() << "Hints for Background image | Edge: " << i.key() << ", Brightness: " << i.value().brightness << ", Busy: " << i.value().busy;
+    }
+
+    return edges;
+}
+
+void BackgroundCache::updateHintsFor(QString imageFile)
+{
+    if (m_hintsCache.contains(imageFile) || m_pendingCalculations.contains(imageFile)) {
+        return;
+    }
+
+    if (m_hintsCache.size() > MAXHASHSIZE) {
+        cleanupHashes();
+    }
+
+    if (loadHintsFromDisk(imageFile)) {
+        return;
+    }
+
+    //! views are receiving neutral hints until the calculations are finished
+    auto watcher = new QFutureWatcher<EdgesHash>(this);
+    m_pendingCalculations[imageFile] = watcher;
 
-        brightness = subBrightnessSum / subBrightness.count();
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, imageFile]() {
+        imageCalculationsFinished(imageFile);
+    });
 
-        bool areaBusy = areaIsBusy(minBrightness, maxBrightness);
+    watcher->setFuture(QtConcurrent::run(&BackgroundCache::imageCalculations, imageFile));
+}
+
+void BackgroundCache::imageCalculationsFinished(QString imageFile)
+{
+    if (!m_pendingCalculations.contains(imageFile)) {
+        return;
+    }
+
+    auto watcher = m_pendingCalculations.take(imageFile);
+
+    //! images that can not be decoded are cached with no hints in order to not be decoded again
+    m_hintsCache[imageFile] = watcher->result();
+    watcher->deleteLater();
+
+    if (!m_hintsCache[imageFile].isEmpty()) {
+        saveHintsToDisk(imageFile);
+    }
+
+    emit hintsChanged(imageFile);
+}
+
+bool BackgroundCache::loadHintsFromDisk(QString imageFile)
+{
+    QFileInfo imageInfo(imageFile);
+
+    if (!imageInfo.exists()) {
+        return false;
+    }
+
+    const QString groupName = QCryptographicHash::hash(imageFile.toUtf8(), QCryptographicHash::Md5).toHex();
+
+    if (!m_hintsConfig->hasGroup(groupName)) {
+        return false;
+    }
+
+    KConfigGroup imageGroup = m_hintsConfig->group(groupName);
+
+    if (imageGroup.readEntry("file", QString()) != imageFile
+            || imageGroup.readEntry("lastModified", (qint64)0) != imageInfo.lastModified().toMSecsSinceEpoch()
+            || imageGroup.readEntry("size", (qint64)-1) != imageInfo.size()) {
+        return false;
+    }
+
+    EdgesHash edges;
+
+    for (const auto location : {Plasma::Types::TopEdge, Plasma::Types::BottomEdge, Plasma::Types::LeftEdge, Plasma::Types::RightEdge}) {
+        KConfigGroup edgeGroup = imageGroup.group(QString::number(location));
+
+        imageHints iHints;
+        iHints.brightness = edgeGroup.readEntry("brightness", (float)-1000);
+        iHints.busy = edgeGroup.readEntry("busy", false);
+
+        edges[location] = iHints;
+    }
 
-        qDebug() << "Hints for Background image | Brightness: " << brightness << ", Busy: " << areaBusy << ", minBright:" << minBrightness << ", maxBright:" << maxBrightness;
+    m_hintsCache[imageFile] = edges;
 
-        if (!m_hintsCache.keys().contains(imageFile)) {
-            m_hintsCache[imageFile] = EdgesHash();
+    return true;
+}
+
+void BackgroundCache::saveHintsToDisk(QString imageFile)
+{
+    QFileInfo imageInfo(imageFile);
+
+    if (!imageInfo.exists() || !m_hintsCache.contains(imageFile)) {
+        return;
+    }
+
+    if (m_hintsConfig->groupList().count() > MAXDISKHASHSIZE) {
+        cleanupDiskHints();
+    }
+
+    const QString groupName = QCryptographicHash::hash(imageFile.toUtf8(), QCryptographicHash::Md5).toHex();
+
+    KConfigGroup imageGroup = m_hintsConfig->group(groupName);
+    imageGroup.writeEntry("file", imageFile);
+    imageGroup.writeEntry("lastModified", imageInfo.lastModified().toMSecsSinceEpoch());
+    imageGroup.writeEntry("size", imageInfo.size());
+
+    const EdgesHash &edges = m_hintsCache[imageFile];
+
+    for (EdgesHash::const_iterator i=edges.constBegin(); i!=edges.constEnd(); ++i) {
+        KConfigGroup edgeGroup = imageGroup.group(QString::number(i.key()));
+        edgeGroup.writeEntry("brightness", i.value().brightness);
+        edgeGroup.writeEntry("busy", i.value().busy);
+    }
+
+    m_hintsConfig->sync();
+}
+
+void BackgroundCache::cleanupDiskHints()
+{
+    //! remove hints for images that were deleted or changed
+    for (const auto &groupName : m_hintsConfig->groupList()) {
+        KConfigGroup imageGroup = m_hintsConfig->group(groupName);
+        QFileInfo imageInfo(imageGroup.readEntry("file", QString()));
+
+        if (!imageInfo.exists()
+                || imageGroup.readEntry("lastModified", (qint64)0) != imageInfo.lastModified().toMSecsSinceEpoch()) {
+            imageGroup.deleteGroup();
         }
+    }
 
-        if (!m_hintsCache[imageFile].contains(location)) {
-            imageHints iHints;
-            iHints.brightness = brightness; iHints.busy = areaBusy;
-            m_hintsCache[imageFile].insert(location, iHints);
-        } else {
-            m_hintsCache[imageFile][location].brightness = brightness;
-            m_hintsCache[imageFile][location].busy = areaBusy;
+    if (m_hintsConfig->groupList().count() > MAXDISKHASHSIZE) {
+        for (const auto &groupName : m_hintsConfig->groupList()) {
+            m_hintsConfig->deleteGroup(groupName);
         }
     }
 }
 
+imageHints BackgroundCache::hintsFromTiles(const QList<float> &tilesBrightness)
+{
+    imageHints hints;
+
+    if (tilesBrightness.isEmpty()) {
+        return hints;
+    }
+
+    float maxBrightness{0};
+    float minBrightness{255};
+    float brightnessSum{0};
+
+    for (const auto tileBrightness : tilesBrightness) {
+        brightnessSum += tileBrightness;
+        maxBrightness = qMax(maxBrightness, tileBrightness);
+        minBrightness = qMin(minBrightness, tileBrightness);
+    }
+
+    hints.brightness = brightnessSum / tilesBrightness.count();
+    hints.busy = areaIsBusy(minBrightness, maxBrightness);
+
+    return hints;
+}
+
 float BackgroundCache::brightnessForFile(QString imageFile, Plasma::Types::Location location)
 {
     if (m_hintsCache.keys().contains(imageFile)) {
@@ -393,7 +552,7 @@ float BackgroundCache::brightnessForFile(QString imageFile, Plasma::Types::Locat
         return Latte::colorBrightness(QColor(imageFile));
     }
 
-    updateImageCalculations(imageFile, location);
+    updateHintsFor(imageFile);
 
     if (m_hintsCache.keys().contains(imageFile)) {
         return m_hintsCache[imageFile][location].brightness;
@@ -415,7 +574,7 @@ bool BackgroundCache::busyForFile(QString imageFile, Plasma::Types::Location loc
         return false;
     }
 
-    updateImageCalculations(imageFile, location);
+    updateHintsFor(imageFile);
 
     if (m_hintsCache.keys().contains(imageFile)) {
         return m_hintsCache[imageFile][location].busy;
@@ -24,6 +24,7 @@
 #include "screenpool.h"
 
 // Qt
+#include <QFutureWatcher>
 #include <QHash>
 #include <QObject>
 
@@ -55,6 +56,9 @@ public:
     bool busyFor(QString activity, QString screen, Plasma::Types::Location location);
     float brightnessFor(QString activity, QString screen, Plasma::Types::Location location);
 
+    //! hints are calculated in the background the first time an image is requested
+    bool hintsArePendingFor(QString activity, QString screen) const;
+
     QString background(QString activity, QString screen) const;
 
     void setBackgroundFromBroadcast(QString activity, QString screen, QString filename);
@@ -62,6 +66,8 @@ public:
 
 signals:
     void backgroundChanged(const QString &activity, const QString &screenName);
+    //! hints for imageFile were calculated in the background
+    void hintsChanged(const QString &imageFile);
 
 private slots:
     void reload();
@@ -72,16 +78,25 @@ private:
 
     bool backgroundIsBroadcasted(QString activity, QString screenName) const;
     bool pluginExistsFor(QString activity, QString screenName) const;
-    bool areaIsBusy(float bright1, float bright2) const;
     bool busyForFile(QString imageFile, Plasma::Types::Location location);
     bool isDesktopContainment(const KConfigGroup &containment) const;
 
     float brightnessForFile(QString imageFile, Plasma::Types::Location location);
-    float brightnessFromArea(QImage &image, int firstRow, int firstColumn, int endRow, int endColumn);
     QString backgroundFromConfig(const KConfigGroup &config, QString wallpaperPlugin) const;
 
     void cleanupHashes();
-    void updateImageCalculations(QString imageFile, Plasma::Types::Location location);
+    void updateHintsFor(QString imageFile);
+    void imageCalculationsFinished(QString imageFile);
+
+    //! hints stored on disk for images that have not changed since their calculation
+    bool loadHintsFromDisk(QString imageFile);
+    void saveHintsToDisk(QString imageFile);
+    void cleanupDiskHints();
+
+    //! image calculations are running in a worker thread, they must not access any members
+    static bool areaIsBusy(float bright1, float bright2);
+    static imageHints hintsFromTiles(const QList<float> &tilesBrightness);
+    static EdgesHash imageCalculations(QString imageFile);
 
 private:
     bool m_initialized{false};
@@ -103,7 +118,11 @@ private:
     //! image file and brightness per edge
     QHash<QString, EdgesHash> m_hintsCache;
 
+    //! image files whose hints are currently calculated in the background
+    QHash<QString, QFutureWatcher<EdgesHash> *> m_pendingCalculations;
+
     KSharedConfig::Ptr m_plasmaConfig;
+    KSharedConfig::Ptr m_hintsConfig;
 };
 
 }
@@ -33,6 +33,7 @@ BackgroundTracker::BackgroundTracker(QObject *parent)
     connect(this, &BackgroundTracker::screenNameChanged, this, &BackgroundTracker::update);
 
     connect(PlasmaExtended::BackgroundCache::self(), &PlasmaExtended::BackgroundCache::backgroundChanged, this, &BackgroundTracker::backgroundChanged);
+    connect(PlasmaExtended::BackgroundCache::self(), &PlasmaExtended::BackgroundCache::hintsChanged, this, &BackgroundTracker::hintsChanged);
 }
 
 BackgroundTracker::~BackgroundTracker()
@@ -106,14 +107,29 @@ void BackgroundTracker::backgroundChanged(const QString &activity, const QString
     }
 }
 
+void BackgroundTracker::hintsChanged(const QString &imageFile)
+{
+    if (PlasmaExtended::BackgroundCache::self()->background(m_activity, m_screenName) == imageFile) {
+        update();
+    }
+}
+
 void BackgroundTracker::update()
 {
     if (m_activity.isEmpty() || m_screenName.isEmpty()) {
         return;
     }
 
-    m_brightness = PlasmaExtended::BackgroundCache::self()->brightnessFor(m_activity, m_screenName, m_location);
-    m_busy = PlasmaExtended::BackgroundCache::self()->busyFor(m_activity, m_screenName, m_location);
+    float brightness = PlasmaExtended::BackgroundCache::self()->brightnessFor(m_activity, m_screenName, m_location);
+    bool busy = PlasmaExtended::BackgroundCache::self()->busyFor(m_activity, m_screenName, m_location);
+
+    //! keep the last known hints until the background calculations are finished
+    if (PlasmaExtended::BackgroundCache::self()->hintsArePendingFor(m_activity, m_screenName) && m_brightness != -1000) {
+        return;
+    }
+
+    m_brightness = brightness;
+    m_busy = busy;
 
     emit currentBrightnessChanged();
     emit isBusyChanged();
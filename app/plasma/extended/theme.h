@@ -28,6 +28,7 @@
 #include <QObject>
 #include <QHash>
 #include <QTemporaryDir>
+#include <QVector>
 
 // KDE
 #include <KConfigGroup>
@@ -54,10 +55,9 @@ namespace Latte {
 namespace PlasmaExtended {
 
 struct CornerRegions {
-    QRegion topLeft;
-    QRegion topRight;
-    QRegion bottomLeft;
-    QRegion bottomRight;
+    //! masked width of the top left corner for each row starting from its top,
+    //! the rest corners are its mirrored versions
+    QVector<int> rowWidths;
 };
 
 class Theme: public QObject
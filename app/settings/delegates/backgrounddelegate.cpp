@@ -22,6 +22,7 @@
 // local
 #include "../models/layoutsmodel.h"
 #include "../tools/settingstools.h"
+#include "../tools/thumbnailscache.h"
 
 // Qt
 #include <QDebug>
@@ -89,16 +90,22 @@ void BackgroundDelegate::drawIcon(QPainter *painter, const QStyleOptionViewItem
         int backImageMargin = qMin(option.rect.height()/4, MARGIN+2);
         QRect backTarget(target.x() + backImageMargin, target.y() + backImageMargin, target.width() - 2*backImageMargin, target.height() - 2*backImageMargin);
 
-        QPixmap backImage(icon.name);
-        backImage = backImage.copy(backTarget);
+        QPixmap backImage = Settings::ThumbnailsCache::self()->thumbnail(icon.name, backTarget.size(), option.widget);
 
         QPalette::ColorRole textColorRole = selected ? QPalette::HighlightedText : QPalette::Text;
 
-        QBrush imageBrush(backImage);
         QPen pen; pen.setWidth(1);
         pen.setColor(option.palette.color(Latte::colorGroup(option), textColorRole));
 
-        painter->setBrush(imageBrush);
+        if (!backImage.isNull()) {
+            QBrush imageBrush(backImage);
+            imageBrush.setTransform(QTransform::fromTranslate(backTarget.x(), backTarget.y()));
+            painter->setBrush(imageBrush);
+        } else {
+            //! placeholder until the thumbnail is ready
+            painter->setBrush(option.palette.color(Latte::colorGroup(option), QPalette::Mid));
+        }
+
         painter->setPen(pen);
 
         painter->drawEllipse(backTarget);
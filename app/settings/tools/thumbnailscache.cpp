@@ -0,0 +1,221 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "thumbnailscache.h"
+
+// Qt
+#include <QAbstractItemView>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QStandardPaths>
+#include <QWidget>
+#include <QtConcurrent>
+
+// C++
+#include <utime.h>
+
+#define THUMBNAILSDIR "lattedock/thumbnails"
+#define MAXTHUMBNAILS 100
+//! disk thumbnails that have not been used for that many days are removed, their
+//! modification time is updated whenever they are loaded
+#define MAXTHUMBNAILAGE 30
+
+namespace Latte {
+namespace Settings {
+
+ThumbnailsCache::ThumbnailsCache(QObject *parent)
+    : QObject(parent),
+      m_thumbnails(MAXTHUMBNAILS)
+{
+    m_thumbnailsDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + THUMBNAILSDIR;
+    QDir().mkpath(m_thumbnailsDir);
+
+    //! pixmaps must be released and pending thumbnails must be finished before the application
+    connect(qApp, &QCoreApplication::aboutToQuit, this, [this]() {
+        m_thumbnails.clear();
+        waitPendingThumbnails();
+    });
+
+    cleanupDiskThumbnails();
+}
+
+ThumbnailsCache::~ThumbnailsCache()
+{
+    waitPendingThumbnails();
+}
+
+ThumbnailsCache *ThumbnailsCache::self()
+{
+    //! owned by the application, so it is destroyed before the thread pool and not during static destruction
+    static ThumbnailsCache *cache = new ThumbnailsCache(qApp);
+    return cache;
+}
+
+void ThumbnailsCache::waitPendingThumbnails()
+{
+    for (const auto watcher : m_pendingThumbnails) {
+        watcher->waitForFinished();
+    }
+
+    qDeleteAll(m_pendingThumbnails);
+    m_pendingThumbnails.clear();
+    m_requesters.clear();
+}
+
+void ThumbnailsCache::cleanupDiskThumbnails()
+{
+    QDir thumbnailsDir(m_thumbnailsDir);
+    const QDateTime expiration = QDateTime::currentDateTime().addDays(-MAXTHUMBNAILAGE);
+
+    for (const auto &thumbnail : thumbnailsDir.entryInfoList(QDir::Files)) {
+        if (thumbnail.lastModified() < expiration) {
+            QFile::remove(thumbnail.absoluteFilePath());
+        }
+    }
+}
+
+QString ThumbnailsCache::diskFile(const QString &key) const
+{
+    return m_thumbnailsDir + QLatin1Char('/') + QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5).toHex() + QLatin1String(".png");
+}
+
+QPixmap ThumbnailsCache::thumbnail(const QString &imageFile, const QSize &size, const QWidget *requester)
+{
+    QFileInfo imageInfo(imageFile);
+
+    if (!imageInfo.exists() || size.isEmpty()) {
+        return QPixmap();
+    }
+
+    const QString key = imageFile + QLatin1Char(':') + QString::number(imageInfo.lastModified().toMSecsSinceEpoch())
+            + QLatin1Char(':') + QString::number(size.width()) + QLatin1Char('x') + QString::number(size.height());
+
+    if (QPixmap *thumbnail = m_thumbnails.object(key)) {
+        return *thumbnail;
+    }
+
+    if (m_failedThumbnails.contains(key)) {
+        return QPixmap();
+    }
+
+    if (requester && !m_requesters[key].contains(requester)) {
+        m_requesters[key] << requester;
+    }
+
+    if (!m_pendingThumbnails.contains(key)) {
+        auto watcher = new QFutureWatcher<QImage>(this);
+        m_pendingThumbnails[key] = watcher;
+
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, key]() {
+            thumbnailCreated(key);
+        });
+
+        watcher->setFuture(QtConcurrent::run(&ThumbnailsCache::createThumbnail, imageFile, size, diskFile(key)));
+    }
+
+    return QPixmap();
+}
+
+void ThumbnailsCache::thumbnailCreated(const QString &key)
+{
+    if (!m_pendingThumbnails.contains(key)) {
+        return;
+    }
+
+    auto watcher = m_pendingThumbnails.take(key);
+    QImage thumbnail = watcher->result();
+    watcher->deleteLater();
+
+    if (thumbnail.isNull()) {
+        m_failedThumbnails << key;
+    } else {
+        m_thumbnails.insert(key, new QPixmap(QPixmap::fromImage(thumbnail)));
+    }
+
+    for (const auto &requester : m_requesters.take(key)) {
+        if (!requester) {
+            continue;
+        }
+
+        QWidget *widget = const_cast<QWidget *>(requester.data());
+        auto view = qobject_cast<QAbstractItemView *>(widget);
+
+        if (view) {
+            view->viewport()->update();
+        } else {
+            widget->update();
+        }
+    }
+}
+
+QImage ThumbnailsCache::createThumbnail(const QString &imageFile, const QSize &size, const QString &diskFile)
+{
+    QImage thumbnail(diskFile);
+
+    if (!thumbnail.isNull()) {
+        //! access times are not reliable because of relatime/noatime mounts, the used
+        //! thumbnails are kept alive through their modification time instead
+        utime(QFile::encodeName(diskFile).constData(), nullptr);
+        return thumbnail;
+    }
+
+    QImageReader reader(imageFile);
+    QSize imageSize = reader.size();
+
+    //! delegates are painting the background image in its original resolution, so
+    //! the thumbnail is the centered part of the image that fits in the requested size;
+    //! readers that support clipping are decoding only that part
+    if (imageSize.isValid()) {
+        QRect clip(QPoint(0, 0), size.boundedTo(imageSize));
+        clip.moveCenter(QRect(QPoint(0, 0), imageSize).center());
+
+        if (reader.supportsOption(QImageIOHandler::ClipRect)) {
+            reader.setClipRect(clip);
+            thumbnail = reader.read();
+        } else {
+            thumbnail = reader.read().copy(clip);
+        }
+    } else {
+        thumbnail = reader.read();
+
+        if (!thumbnail.isNull()) {
+            QRect clip(QPoint(0, 0), size.boundedTo(thumbnail.size()));
+            clip.moveCenter(thumbnail.rect().center());
+            thumbnail = thumbnail.copy(clip);
+        }
+    }
+
+    if (thumbnail.isNull()) {
+        qDebug() << "Thumbnails :: image could not be read :: " << imageFile << " : " << reader.errorString();
+        return thumbnail;
+    }
+
+    thumbnail.save(diskFile, "PNG");
+
+    return thumbnail;
+}
+
+}
+}
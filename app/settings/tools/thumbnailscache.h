@@ -0,0 +1,80 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SETTINGSTHUMBNAILSCACHE_H
+#define SETTINGSTHUMBNAILSCACHE_H
+
+// Qt
+#include <QCache>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QPointer>
+#include <QSet>
+#include <QSize>
+
+class QWidget;
+
+namespace Latte {
+namespace Settings {
+
+//! Thumbnails of layout background images that are painted from the settings
+//! delegates. Thumbnails are created in a worker thread, they are kept in memory
+//! and on disk and they are identified by image file, modification time and size
+class ThumbnailsCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ThumbnailsCache *self();
+    ~ThumbnailsCache() override;
+
+    //! returns a null pixmap when the thumbnail is not ready yet, in such case
+    //! the requester widget is updated when the thumbnail becomes available
+    QPixmap thumbnail(const QString &imageFile, const QSize &size, const QWidget *requester);
+
+private:
+    ThumbnailsCache(QObject *parent = nullptr);
+
+    void cleanupDiskThumbnails();
+    void waitPendingThumbnails();
+    void thumbnailCreated(const QString &key);
+
+    QString diskFile(const QString &key) const;
+
+    static QImage createThumbnail(const QString &imageFile, const QSize &size, const QString &diskFile);
+
+private:
+    QString m_thumbnailsDir;
+
+    QCache<QString, QPixmap> m_thumbnails;
+    //! thumbnails that can not be created are not requested again
+    QSet<QString> m_failedThumbnails;
+
+    QHash<QString, QFutureWatcher<QImage> *> m_pendingThumbnails;
+    QHash<QString, QList<QPointer<const QWidget>>> m_requesters;
+};
+
+}
+}
+
+#endif
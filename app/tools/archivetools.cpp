@@ -0,0 +1,86 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "archivetools.h"
+
+// Qt
+#include <QBuffer>
+
+// KDE
+#include <KArchive/KArchiveDirectory>
+#include <KArchive/KArchiveEntry>
+#include <KArchive/KArchiveFile>
+
+namespace Latte {
+
+int configVersion(const QByteArray &contents, const QString &groupName)
+{
+    QBuffer buffer;
+    buffer.setData(contents);
+
+    if (!buffer.open(QIODevice::ReadOnly)) {
+        return 1;
+    }
+
+    const QByteArray groupHeader = '[' + groupName.toUtf8() + ']';
+    bool inGroup{false};
+    int version{1};
+
+    //! only the simple "[Group]" and "key=value" lines are needed, when a group
+    //! is found more than once its last entry is used, same as KConfig
+    while (!buffer.atEnd()) {
+        const QByteArray line = buffer.readLine().trimmed();
+
+        if (line.startsWith('[')) {
+            inGroup = (line == groupHeader);
+            continue;
+        }
+
+        if (!inGroup) {
+            continue;
+        }
+
+        const int equalPos = line.indexOf('=');
+
+        if (equalPos > 0 && line.left(equalPos).trimmed() == "version") {
+            bool ok{false};
+            const int value = line.mid(equalPos + 1).trimmed().toInt(&ok);
+
+            if (ok) {
+                version = value;
+            }
+        }
+    }
+
+    return version;
+}
+
+int archivedConfigVersion(const KArchiveDirectory *rootDir, const QString &fileName, const QString &groupName)
+{
+    const KArchiveEntry *entry = rootDir ? rootDir->entry(fileName) : nullptr;
+
+    if (!entry || !entry->isFile()) {
+        return -1;
+    }
+
+    return configVersion(static_cast<const KArchiveFile *>(entry)->data(), groupName);
+}
+
+}
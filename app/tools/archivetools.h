@@ -0,0 +1,42 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ARCHIVETOOLS_H
+#define ARCHIVETOOLS_H
+
+// Qt
+#include <QByteArray>
+#include <QString>
+
+class KArchiveDirectory;
+
+namespace Latte {
+
+//! returns the "version" entry of a config group from the config file contents,
+//! 1 is returned when the entry is not found, same as the KConfig default
+int configVersion(const QByteArray &contents, const QString &groupName);
+
+//! returns the "version" entry of a config group from a config file that is stored
+//! in an archive. The file is read in memory without extracting it, -1 is returned
+//! when the file does not exist in the archive
+int archivedConfigVersion(const KArchiveDirectory *rootDir, const QString &fileName, const QString &groupName);
+}
+
+#endif
@@ -25,6 +25,19 @@
 #include <QStandardPaths>
 #include <QtMath>
 
+// SIMD
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LATTE_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+
+//! 32bit accumulators can hold safely that many vectorized iterations
+#define MAXBRIGHTNESSITERATIONS 4096
+
 namespace Latte {
 
 float colorBrightness(QColor color)
@@ -45,6 +58,142 @@ float colorBrightness(float r, float g, float b)
 }
 
 
+//! QRgb is 0xAARRGGBB, so in memory each pixel is found as B,G,R,A
+static quint64 colorsBrightnessSumScalar(const QRgb *pixels, int count)
+{
+    quint64 sum{0};
+
+    for (int i=0; i<count; ++i) {
+        sum += qRed(pixels[i]) * 299 + qGreen(pixels[i]) * 587 + qBlue(pixels[i]) * 114;
+    }
+
+    return sum;
+}
+
+#if defined(__SSE2__)
+static quint64 colorsBrightnessSumSse2(const QRgb *pixels, int count)
+{
+    const __m128i weights = _mm_setr_epi16(114, 587, 299, 0, 114, 587, 299, 0);
+    const __m128i zero = _mm_setzero_si128();
+
+    const int vectorEnd = count - (count % 4);
+
+    quint64 sum{0};
+    int i{0};
+
+    while (i < vectorEnd) {
+        __m128i accumulator = _mm_setzero_si128();
+        const int blockEnd = qMin(vectorEnd, i + 4 * MAXBRIGHTNESSITERATIONS);
+
+        for (; i < blockEnd; i += 4) {
+            const __m128i pixels4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+            const __m128i low = _mm_madd_epi16(_mm_unpacklo_epi8(pixels4, zero), weights);
+            const __m128i high = _mm_madd_epi16(_mm_unpackhi_epi8(pixels4, zero), weights);
+            accumulator = _mm_add_epi32(accumulator, _mm_add_epi32(low, high));
+        }
+
+        quint32 lanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), accumulator);
+        sum += quint64(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    return sum + colorsBrightnessSumScalar(pixels + i, count - i);
+}
+#endif
+
+#if defined(LATTE_AVX2_DISPATCH)
+__attribute__((target("avx2")))
+static quint64 colorsBrightnessSumAvx2(const QRgb *pixels, int count)
+{
+    const __m256i weights = _mm256_setr_epi16(114, 587, 299, 0, 114, 587, 299, 0,
+                                              114, 587, 299, 0, 114, 587, 299, 0);
+    const __m256i zero = _mm256_setzero_si256();
+
+    const int vectorEnd = count - (count % 8);
+
+    quint64 sum{0};
+    int i{0};
+
+    while (i < vectorEnd) {
+        __m256i accumulator = _mm256_setzero_si256();
+        const int blockEnd = qMin(vectorEnd, i + 8 * MAXBRIGHTNESSITERATIONS);
+
+        for (; i < blockEnd; i += 8) {
+            const __m256i pixels8 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+            const __m256i low = _mm256_madd_epi16(_mm256_unpacklo_epi8(pixels8, zero), weights);
+            const __m256i high = _mm256_madd_epi16(_mm256_unpackhi_epi8(pixels8, zero), weights);
+            accumulator = _mm256_add_epi32(accumulator, _mm256_add_epi32(low, high));
+        }
+
+        quint32 lanes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), accumulator);
+
+        for (int l=0; l<8; ++l) {
+            sum += lanes[l];
+        }
+    }
+
+    return sum + colorsBrightnessSumScalar(pixels + i, count - i);
+}
+#endif
+
+bool brightnessKernelIsSupported(BrightnessKernel kernel)
+{
+    switch (kernel) {
+    case BrightnessKernel::Scalar:
+        return true;
+    case BrightnessKernel::Sse2:
+#if defined(__SSE2__)
+        return true;
+#else
+        return false;
+#endif
+    case BrightnessKernel::Avx2:
+#if defined(LATTE_AVX2_DISPATCH)
+        {
+            static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+            return hasAvx2;
+        }
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+quint64 colorsBrightnessSum(const QRgb *pixels, int count, BrightnessKernel kernel)
+{
+    if (!pixels || count <= 0) {
+        return 0;
+    }
+
+    if (!brightnessKernelIsSupported(kernel)) {
+        kernel = BrightnessKernel::Scalar;
+    }
+
+    switch (kernel) {
+#if defined(LATTE_AVX2_DISPATCH)
+    case BrightnessKernel::Avx2:
+        return colorsBrightnessSumAvx2(pixels, count);
+#endif
+#if defined(__SSE2__)
+    case BrightnessKernel::Sse2:
+        return colorsBrightnessSumSse2(pixels, count);
+#endif
+    default:
+        return colorsBrightnessSumScalar(pixels, count);
+    }
+}
+
+quint64 colorsBrightnessSum(const QRgb *pixels, int count)
+{
+    static const BrightnessKernel kernel = brightnessKernelIsSupported(BrightnessKernel::Avx2) ? BrightnessKernel::Avx2
+                                         : (brightnessKernelIsSupported(BrightnessKernel::Sse2) ? BrightnessKernel::Sse2 : BrightnessKernel::Scalar);
+
+    return colorsBrightnessSum(pixels, count, kernel);
+}
+
 float colorLumina(QRgb rgb)
 {
     float r = (float)(qRed(rgb)) / 255;
@@ -30,6 +30,21 @@ float colorBrightness(QColor color);
 float colorBrightness(QRgb rgb);
 float colorBrightness(float r, float g, float b);
 
+//! sum of colorBrightness()*1000 for consecutive pixels, it is computed with
+//! integer math and it is vectorized when the cpu supports it
+quint64 colorsBrightnessSum(const QRgb *pixels, int count);
+
+enum class BrightnessKernel {
+    Scalar = 0,
+    Sse2,
+    Avx2
+};
+
+//! kernels are exposed in order to be verified and benchmarked against each other,
+//! unsupported kernels from the build or the running cpu fall back to the scalar one
+bool brightnessKernelIsSupported(BrightnessKernel kernel);
+quint64 colorsBrightnessSum(const QRgb *pixels, int count, BrightnessKernel kernel);
+
 float colorLumina(QColor color);
 float colorLumina(QRgb rgb);
 float colorLumina(float r, float g, float b);
@@ -184,46 +184,63 @@ int ContainmentInterface::applicationLauncherId() const
     return launcherId;
 }
 
-bool ContainmentInterface::updateBadgeForLatteTask(const QString identifier, const QString value)
+QList<ContainmentInterface::MethodTarget> ContainmentInterface::badgeTargets(PlasmaQuick::AppletQuickItem *plasmoid)
 {
-    if (!hasLatteTasks()) {
-        return false;
-    }
+    if (m_latteTasksBadgeTargets.contains(plasmoid)) {
+        const auto &targets = m_latteTasksBadgeTargets[plasmoid];
+        bool targetsAreValid{!targets.isEmpty()};
 
-    const auto &applets = m_view->containment()->applets();
+        for (const auto &target : targets) {
+            if (!target.item) {
+                targetsAreValid = false;
+                break;
+            }
+        }
 
-    for (auto *applet : applets) {
-        KPluginMetaData meta = applet->kPackage().metadata();
+        if (targetsAreValid) {
+            return targets;
+        }
+    } else {
+        connect(plasmoid, &QObject::destroyed, this, [&, plasmoid](){
+            m_latteTasksBadgeTargets.remove(plasmoid);
+        });
+    }
 
-        if (meta.pluginId() == "org.kde.latte.plasmoid") {
+    QList<MethodTarget> targets;
 
-            if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-                const auto &childItems = appletInterface->childItems();
+    for (QQuickItem *item : plasmoid->childItems()) {
+        if (auto *metaObject = item->metaObject()) {
+            // not using QMetaObject::invokeMethod to avoid warnings when calling
+            // this on applets that don't have it or other child items since this
+            // is pretty much trial and error.
+            // Also, "var" arguments are treated as QVariant in QMetaObject
 
-                if (childItems.isEmpty()) {
-                    continue;
-                }
+            int methodIndex = metaObject->indexOfMethod("updateBadge(QVariant,QVariant)");
 
-                for (QQuickItem *item : childItems) {
-                    if (auto *metaObject = item->metaObject()) {
-                        // not using QMetaObject::invokeMethod to avoid warnings when calling
-                        // this on applets that don't have it or other child items since this
-                        // is pretty much trial and error.
-                        // Also, "var" arguments are treated as QVariant in QMetaObject
+            if (methodIndex == -1) {
+                continue;
+            }
 
-                        int methodIndex = metaObject->indexOfMethod("updateBadge(QVariant,QVariant)");
+            targets << MethodTarget{item, metaObject->method(methodIndex)};
+        }
+    }
 
-                        if (methodIndex == -1) {
-                            continue;
-                        }
+    m_latteTasksBadgeTargets[plasmoid] = targets;
 
-                        QMetaMethod method = metaObject->method(methodIndex);
+    return targets;
+}
 
-                        if (method.invoke(item, Q_ARG(QVariant, identifier), Q_ARG(QVariant, value))) {
-                            return true;
-                        }
-                    }
-                }
+bool ContainmentInterface::updateBadgeForLatteTask(const QString identifier, const QString value)
+{
+    if (!hasLatteTasks()) {
+        return false;
+    }
+
+    //! latte tasks plasmoids and their updateBadge() methods are resolved only once
+    for (auto *plasmoid : m_latteTasksModel->tasks()) {
+        for (const auto &target : badgeTargets(plasmoid)) {
+            if (target.method.invoke(target.item, Q_ARG(QVariant, identifier), Q_ARG(QVariant, value))) {
+                return true;
             }
         }
     }
@@ -115,11 +115,18 @@ private slots:
     void onPlasmaTasksCountChanged();
 
 private:
+    struct MethodTarget {
+        QPointer<QQuickItem> item;
+        QMetaMethod method;
+    };
+
     void addExpandedApplet(PlasmaQuick::AppletQuickItem * appletQuickItem);
     void removeExpandedApplet(PlasmaQuick::AppletQuickItem *appletQuickItem);
 
     bool appletIsExpandable(PlasmaQuick::AppletQuickItem *appletQuickItem);
 
+    QList<MethodTarget> badgeTargets(PlasmaQuick::AppletQuickItem *plasmoid);
+
 private:
     bool m_hasLatteTasks{false};
     bool m_hasPlasmaTasks{false};
@@ -143,6 +150,9 @@ private:
     //!keep record of applet ids and avoid crashes when trying to access ids for already destroyed applets
     QHash<PlasmaQuick::AppletQuickItem *, int> m_expandedAppletIds;
     QHash<PlasmaQuick::AppletQuickItem *, QMetaObject::Connection> m_appletsExpandedConnections;
+
+    //! latte tasks plasmoid -> its child items that provide updateBadge()
+    QHash<PlasmaQuick::AppletQuickItem *, QList<MethodTarget>> m_latteTasksBadgeTargets;
 };
 
 }
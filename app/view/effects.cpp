@@ -34,6 +34,8 @@
 #include <KWindowEffects>
 #include <KWindowSystem>
 
+//! custom masks are cached for the sizes used during resize animations
+#define MAXCUSTOMMASKS 50
 
 namespace Latte {
 namespace ViewPart {
@@ -287,6 +289,7 @@ void Effects::setMask(QRect area)
         return;
 
     m_mask = area;
+    m_combinedMaskDirty = true;
     updateMask();
 
     // qDebug() << "dock mask set:" << m_mask;
@@ -321,6 +324,7 @@ void Effects::forceMaskRedraw()
     m_background->setImagePath(QStringLiteral("widgets/panel-background"));
     m_background->setEnabledBorders(m_enabledBorders);
 
+    m_forceMaskApply = true;
     updateMask();
 }
 
@@ -330,7 +334,17 @@ void Effects::setSubtractedMaskRegion(const QString &regionid, const QRegion &re
         return;
     }
 
+    bool isNewRegion = !m_subtractedMaskRegions.contains(regionid);
     m_subtractedMaskRegions[regionid] = region;
+
+    if (isNewRegion) {
+        //! new regions are just added to the subtracted ones
+        m_subtractedMaskUnion = m_subtractedMaskUnion.united(region);
+    } else {
+        updateSubtractedMaskUnion();
+    }
+
+    m_combinedMaskDirty = true;
     emit subtractedMaskRegionsChanged();
 }
 
@@ -341,6 +355,9 @@ void Effects::removeSubtractedMaskRegion(const QString &regionid)
     }
 
     m_subtractedMaskRegions.remove(regionid);
+    updateSubtractedMaskUnion();
+
+    m_combinedMaskDirty = true;
     emit subtractedMaskRegionsChanged();
 }
 
@@ -350,7 +367,21 @@ void Effects::setUnitedMaskRegion(const QString &regionid, const QRegion &region
         return;
     }
 
+    bool isNewRegion = !m_unitedMaskRegions.contains(regionid);
     m_unitedMaskRegions[regionid] = region;
+
+    if (isNewRegion) {
+        //! new regions are just added to the united ones and to the combined mask
+        m_unitedMaskUnion = m_unitedMaskUnion.united(region);
+
+        if (!m_combinedMaskDirty) {
+            m_combinedMaskRegion = m_combinedMaskRegion.united(region);
+        }
+    } else {
+        updateUnitedMaskUnion();
+        m_combinedMaskDirty = true;
+    }
+
     emit unitedMaskRegionsChanged();
 }
 
@@ -361,55 +392,113 @@ void Effects::removeUnitedMaskRegion(const QString &regionid)
     }
 
     m_unitedMaskRegions.remove(regionid);
+    updateUnitedMaskUnion();
+
+    m_combinedMaskDirty = true;
     emit unitedMaskRegionsChanged();
 }
 
-QRegion Effects::customMask(const QRect &rect)
+void Effects::updateSubtractedMaskUnion()
 {
-    QRegion result = rect;
-    int dx = rect.right() - m_cornersMaskRegion.topLeft.boundingRect().width() + 1;
-    int dy = rect.bottom() - m_cornersMaskRegion.topLeft.boundingRect().height() + 1;
+    m_subtractedMaskUnion = QRegion();
 
-    if (m_hasTopLeftCorner) {
-        QRegion tl = m_cornersMaskRegion.topLeft;
-        tl.translate(rect.x(), rect.y());
-        result = result.subtracted(tl);
+    for(const auto &subregion : m_subtractedMaskRegions) {
+        m_subtractedMaskUnion = m_subtractedMaskUnion.united(subregion);
     }
+}
 
-    if (m_hasTopRightCorner) {
-        QRegion tr = m_cornersMaskRegion.topRight;
-        tr.translate(rect.x() + dx, rect.y());
-        result = result.subtracted(tr);
-    }
+void Effects::updateUnitedMaskUnion()
+{
+    m_unitedMaskUnion = QRegion();
 
-    if (m_hasBottomRightCorner) {
-        QRegion br = m_cornersMaskRegion.bottomRight;
-        br.translate(rect.x() + dx, rect.y() + dy);
-        result = result.subtracted(br);
+    for(const auto &subregion : m_unitedMaskRegions) {
+        m_unitedMaskUnion = m_unitedMaskUnion.united(subregion);
     }
+}
+
+QRegion Effects::customMask(const QRect &rect)
+{
+    const int corners = (m_hasTopLeftCorner ? 1 : 0) | (m_hasTopRightCorner ? 2 : 0)
+            | (m_hasBottomLeftCorner ? 4 : 0) | (m_hasBottomRightCorner ? 8 : 0);
+
+    const QString maskKey = QString::number(rect.width()) + "x" + QString::number(rect.height()) + "-" + QString::number(corners);
 
-    if (m_hasBottomLeftCorner) {
-        QRegion bl = m_cornersMaskRegion.bottomLeft;
-        bl.translate(rect.x(), rect.y() + dy);
-        result = result.subtracted(bl);
+    if (!m_customMasks.contains(maskKey)) {
+        if (m_customMasks.count() > MAXCUSTOMMASKS) {
+            m_customMasks.clear();
+        }
+
+        //! each row is masked from its left and right corners, consecutive rows
+        //! with the same span are merged and the region is built at once
+        const QVector<int> &widths = m_cornersMaskRegion.rowWidths;
+        const int cornerHeight = widths.count();
+        const int width = rect.width();
+        const int height = rect.height();
+
+        QVector<QRect> spans;
+        int spanStart{0};
+        int spanLeft{0};
+        int spanRight{-1};
+
+        for(int y=0; y<=height; ++y) {
+            int left{0};
+            int right{width};
+
+            if (y < height) {
+                const int fromBottom = height - 1 - y;
+
+                if (y < cornerHeight) {
+                    left = m_hasTopLeftCorner ? qMax(left, widths[y]) : left;
+                    right = m_hasTopRightCorner ? qMin(right, width - widths[y]) : right;
+                }
+
+                if (fromBottom < cornerHeight) {
+                    left = m_hasBottomLeftCorner ? qMax(left, widths[fromBottom]) : left;
+                    right = m_hasBottomRightCorner ? qMin(right, width - widths[fromBottom]) : right;
+                }
+            }
+
+            if (y == height || left != spanLeft || right != spanRight) {
+                if (y > spanStart && spanRight > spanLeft) {
+                    spans << QRect(spanLeft, spanStart, spanRight - spanLeft, y - spanStart);
+                }
+
+                spanStart = y;
+                spanLeft = left;
+                spanRight = right;
+            }
+        }
+
+        QRegion mask;
+        mask.setRects(spans.constData(), spans.count());
+        m_customMasks[maskKey] = mask;
     }
 
-    return result;
+    return m_customMasks[maskKey].translated(rect.topLeft());
 }
 
+//! subtracting all regions one after the other is the same with subtracting their union,
+//! so the combined region is (mask - subtracted regions) + united regions and only the
+//! union that was affected from a region change needs to be recomputed
 QRegion Effects::maskCombinedRegion()
 {
-    QRegion region = m_mask;
-
-    for(auto subregion : m_subtractedMaskRegions) {
-        region = region.subtracted(subregion);
+    if (m_combinedMaskDirty) {
+        m_combinedMaskRegion = QRegion(m_mask).subtracted(m_subtractedMaskUnion).united(m_unitedMaskUnion);
+        m_combinedMaskDirty = false;
     }
 
-    for(auto subregion : m_unitedMaskRegions) {
-        region = region.united(subregion);
+    return m_combinedMaskRegion;
+}
+
+void Effects::applyMask(const QRegion &region)
+{
+    //! setting the same mask triggers window system requests for nothing
+    if (!m_forceMaskApply && m_view->mask() == region) {
+        return;
     }
 
-    return region;
+    m_forceMaskApply = false;
+    m_view->setMask(region);
 }
 
 void Effects::updateBackgroundCorners()
@@ -421,6 +510,7 @@ void Effects::updateBackgroundCorners()
     m_corona->themeExtended()->cornersMask(m_backgroundRadius);
 
     m_cornersMaskRegion = m_corona->themeExtended()->cornersMask(m_backgroundRadius);
+    m_customMasks.clear();
     emit backgroundCornersMaskChanged();
 }
 
@@ -429,12 +519,12 @@ void Effects::updateMask()
     if (KWindowSystem::compositingActive()) {
         if (m_view->behaveAsPlasmaPanel()) {
             if (!m_view->visibility()->isHidden()) {
-                m_view->setMask(QRect());
+                applyMask(QRect());
             } else {
-                m_view->setMask(VisibilityManager::ISHIDDENMASK);
+                applyMask(VisibilityManager::ISHIDDENMASK);
             }
         } else {
-            m_view->setMask(maskCombinedRegion());
+            applyMask(maskCombinedRegion());
         }
     } else {
         QRegion fixedMask;
@@ -473,7 +563,7 @@ void Effects::updateMask()
             fixedMask = QRegion(m_mask);
         }
 
-        m_view->setMask(fixedMask);
+        applyMask(fixedMask);
     }
 }
 
@@ -152,10 +152,16 @@ private:
     QRegion customMask(const QRect &rect);
     QRegion maskCombinedRegion();
 
+    void applyMask(const QRegion &region);
+    void updateSubtractedMaskUnion();
+    void updateUnitedMaskUnion();
+
 private:
     bool m_animationsBlocked{false};
     bool m_backgroundAllCorners{false};
     bool m_backgroundRadiusEnabled{false};
+    bool m_combinedMaskDirty{true};
+    bool m_forceMaskApply{false};
     bool m_drawShadows{true};
     bool m_drawEffects{false};
     bool m_forceTopBorder{false};
@@ -185,6 +191,9 @@ private:
 
     PlasmaExtended::CornerRegions m_cornersMaskRegion;
 
+    //! size and corners, custom mask region at (0,0)
+    QHash<QString, QRegion> m_customMasks;
+
     Plasma::Theme m_theme;
     //only for the mask on disabled compositing, not to actually paint
     Plasma::FrameSvg *m_background{nullptr};
@@ -195,6 +204,11 @@ private:
     //! Subtracted and United Mask regions
     QHash<QString, QRegion> m_subtractedMaskRegions;
     QHash<QString, QRegion> m_unitedMaskRegions;
+
+    //! cached unions of subtracted and united mask regions and their combination with mask
+    QRegion m_subtractedMaskUnion;
+    QRegion m_unitedMaskUnion;
+    QRegion m_combinedMaskRegion;
 };
 
 }
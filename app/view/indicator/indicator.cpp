@@ -79,9 +79,8 @@ Indicator::~Indicator()
 {
     unloadIndicators();
 
-    if (m_component) {
-        m_component->deleteLater();
-    }
+    releaseComponent(m_component);
+    releaseComponent(m_plasmaComponent);
 
     if (m_configLoader) {
         m_configLoader->deleteLater();
@@ -262,6 +261,24 @@ void Indicator::load(QString type)
     }
 }
 
+QQmlComponent *Indicator::createComponent(const QString &uiPath)
+{
+    QQmlComponent *component = m_corona ? m_corona->indicatorFactory()->sharedComponent(m_view->engine(), uiPath) : nullptr;
+
+    return component ? component : new QQmlComponent(m_view->engine(), uiPath);
+}
+
+void Indicator::releaseComponent(QQmlComponent *component)
+{
+    if (!component) {
+        return;
+    }
+
+    if (!m_corona || !m_corona->indicatorFactory()->releaseSharedComponent(component)) {
+        component->deleteLater();
+    }
+}
+
 void Indicator::updateComponent()
 {
     auto prevComponent = m_component;
@@ -270,12 +287,10 @@ void Indicator::updateComponent()
 
     if (!uiPath.isEmpty()) {
         uiPath = m_pluginPath + "package/" + uiPath;
-        m_component = new QQmlComponent(m_view->engine(), uiPath);
+        m_component = createComponent(uiPath);
     }
 
-    if (prevComponent) {
-        prevComponent->deleteLater();
-    }
+    releaseComponent(prevComponent);
 }
 
 void Indicator::loadPlasmaComponent()
@@ -290,12 +305,10 @@ void Indicator::loadPlasmaComponent()
         path = path.remove("metadata.desktop");
 
         uiPath = path + "package/" + uiPath;
-        m_plasmaComponent = new QQmlComponent(m_view->engine(), uiPath);
+        m_plasmaComponent = createComponent(uiPath);
     }
 
-    if (prevComponent) {
-        prevComponent->deleteLater();
-    }
+    releaseComponent(prevComponent);
 
     emit plasmaComponentChanged();
 }
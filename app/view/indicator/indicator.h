@@ -145,6 +145,10 @@ private:
 
     void loadPlasmaComponent();
     void updateComponent();
+
+    //! components are shared from the indicators factory when it is possible
+    QQmlComponent *createComponent(const QString &uiPath);
+    void releaseComponent(QQmlComponent *component);
     void updateScheme();
 
 private:
@@ -66,6 +66,7 @@ public:
     void clearPixmaps();
     void setupPixmaps();
     Qt::HANDLE createPixmap(const QPixmap& source);
+    Qt::HANDLE x11Pixmap(const QPixmap &source);
     void initPixmap(const QString &element);
     QPixmap initEmptyPixmap(const QSize &size);
     void updateShadow(const QWindow *window, Plasma::FrameSvg::EnabledBorders);
@@ -98,6 +99,16 @@ public:
     //! graphical context
     xcb_gcontext_t _gc;
     bool m_isX11;
+
+    //! _KDE_NET_WM_SHADOW atom, it is interned only once
+    Atom m_shadowAtom{None};
+    Atom shadowAtom();
+
+    //! server side pixmaps are uploaded only once for each shadow tile and are shared
+    //! between all windows and enabled borders combinations. They are released when
+    //! the theme, prefix or device pixel ratio changes and the tiles are recreated.
+    //! pixmap cacheKey, X11 pixmap
+    QHash<qint64, Qt::HANDLE> m_x11Pixmaps;
 #endif
 
     struct Wayland {
@@ -272,6 +283,35 @@ Qt::HANDLE PanelShadows::Private::createPixmap(const QPixmap& source)
 
 }
 
+Qt::HANDLE PanelShadows::Private::x11Pixmap(const QPixmap &source)
+{
+#if HAVE_X11
+    if (source.isNull()) {
+        return nullptr;
+    }
+
+    if (!m_x11Pixmaps.contains(source.cacheKey())) {
+        m_x11Pixmaps[source.cacheKey()] = createPixmap(source);
+    }
+
+    return m_x11Pixmaps[source.cacheKey()];
+#else
+    Q_UNUSED(source)
+    return nullptr;
+#endif
+}
+
+#if HAVE_X11
+Atom PanelShadows::Private::shadowAtom()
+{
+    if (m_shadowAtom == None) {
+        m_shadowAtom = XInternAtom(QX11Info::display(), "_KDE_NET_WM_SHADOW", False);
+    }
+
+    return m_shadowAtom;
+}
+#endif
+
 void PanelShadows::Private::initPixmap(const QString &element)
 {
     m_shadowPixmaps << q->pixmap(element);
@@ -330,78 +370,78 @@ void PanelShadows::Private::setupData(Plasma::FrameSvg::EnabledBorders enabledBo
     }
     //shadow-top
     if (enabledBorders & Plasma::FrameSvg::TopBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[0]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_shadowPixmaps[0]));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyHorizontalPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyHorizontalPix));
     }
 
     //shadow-topright
     if (enabledBorders & Plasma::FrameSvg::TopBorder &&
         enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[1]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_shadowPixmaps[1]));
     } else if (enabledBorders & Plasma::FrameSvg::TopBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerTopPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerTopPix));
     } else if (enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerRightPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerRightPix));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerPix));
     }
 
     //shadow-right
     if (enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[2]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_shadowPixmaps[2]));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyVerticalPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyVerticalPix));
     }
 
     //shadow-bottomright
     if (enabledBorders & Plasma::FrameSvg::BottomBorder &&
         enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[3]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_shadowPixmaps[3]));
     } else if (enabledBorders & Plasma::FrameSvg::BottomBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerBottomPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerBottomPix));
     } else if (enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerRightPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerRightPix));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerPix));
     }
 
     //shadow-bottom
     if (enabledBorders & Plasma::FrameSvg::BottomBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[4]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_shadowPixmaps[4]));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyHorizontalPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyHorizontalPix));
     }
 
     //shadow-bottomleft
     if (enabledBorders & Plasma::FrameSvg::BottomBorder &&
         enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[5]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_shadowPixmaps[5]));
     } else if (enabledBorders & Plasma::FrameSvg::BottomBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerBottomPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerBottomPix));
     } else if (enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerLeftPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerLeftPix));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerPix));
     }
 
     //shadow-left
     if (enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[6]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_shadowPixmaps[6]));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyVerticalPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyVerticalPix));
     }
 
     //shadow-topleft
     if (enabledBorders & Plasma::FrameSvg::TopBorder &&
         enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[7]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_shadowPixmaps[7]));
     } else if (enabledBorders & Plasma::FrameSvg::TopBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerTopPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerTopPix));
     } else if (enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerLeftPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerLeftPix));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(x11Pixmap(m_emptyCornerPix));
     }
 #endif
 
@@ -467,33 +507,13 @@ void PanelShadows::Private::freeX11Pixmaps()
         return;
     }
 
-    foreach (const QPixmap &pixmap, m_shadowPixmaps) {
-        if (!pixmap.isNull()) {
-            XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(pixmap)));
+    for (const auto pixmap : m_x11Pixmaps) {
+        if (pixmap) {
+            XFreePixmap(display, reinterpret_cast<unsigned long>(pixmap));
         }
     }
 
-    if (!m_emptyCornerPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix)));
-    }
-    if (!m_emptyCornerBottomPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerBottomPix)));
-    }
-    if (!m_emptyCornerLeftPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerLeftPix)));
-    }
-    if (!m_emptyCornerRightPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerRightPix)));
-    }
-    if (!m_emptyCornerTopPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerTopPix)));
-    }
-    if (!m_emptyVerticalPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyVerticalPix)));
-    }
-    if (!m_emptyHorizontalPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyHorizontalPix)));
-    }
+    m_x11Pixmaps.clear();
 #endif
 }
 
@@ -548,7 +568,7 @@ void PanelShadows::Private::updateShadowX11(const QWindow *window, Plasma::Frame
     }
 
     Display *dpy = QX11Info::display();
-    Atom atom = XInternAtom(dpy, "_KDE_NET_WM_SHADOW", False);
+    Atom atom = shadowAtom();
 
 //     qDebug() << "going to set the shadow of" << window->winId() << "to" << data;
     XChangeProperty(dpy, window->winId(), atom, XA_CARDINAL, 32, PropModeReplace,
@@ -678,7 +698,7 @@ void PanelShadows::Private::clearShadowX11(const QWindow* window)
 {
 #if HAVE_X11
     Display *dpy = QX11Info::display();
-    Atom atom = XInternAtom(dpy, "_KDE_NET_WM_SHADOW", False);
+    Atom atom = shadowAtom();
     XDeleteProperty(dpy, window->winId(), atom);
 #endif
 }
@@ -64,6 +64,11 @@ QHash<int, QByteArray> TasksModel::roleNames() const{
     return roles;
 }
 
+QList<PlasmaQuick::AppletQuickItem *> TasksModel::tasks() const
+{
+    return m_tasks;
+}
+
 void TasksModel::addTask(PlasmaQuick::AppletQuickItem *plasmoid)
 {
     if (plasmoid && m_tasks.contains(plasmoid)) {
@@ -43,6 +43,8 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+   QList<PlasmaQuick::AppletQuickItem *> tasks() const;
+
    void addTask(PlasmaQuick::AppletQuickItem *plasmoid);
    void removeTask(PlasmaQuick::AppletQuickItem *plasmoid);
 
@@ -43,6 +43,7 @@
 
 // Qt
 #include <QAction>
+#include <QLoggingCategory>
 #include <QMouseEvent>
 #include <QQmlContext>
 #include <QQmlEngine>
@@ -66,6 +67,10 @@
 #define BLOCKHIDINGNEEDSATTENTIONTYPE "View::Containment::NeedsAttentionState()"
 #define BLOCKHIDINGREQUESTSINPUTTYPE "View::Containment::RequestsInputState()"
 
+//! event rates are reported only when they are requested, e.g.
+//! QT_LOGGING_RULES="org.kde.latte.view.events.debug=true"
+Q_LOGGING_CATEGORY(LATTE_VIEW_EVENTS, "org.kde.latte.view.events", QtWarningMsg)
+
 namespace Latte {
 
 //! both alwaysVisible and byPassWM are passed through corona because
@@ -77,6 +82,30 @@ View::View(Plasma::Corona *corona, QScreen *targetScreen, bool byPassWM)
       m_effects(new ViewPart::Effects(this)),
       m_interface(new ViewPart::ContainmentInterface(this))
 {      
+    //! available screen geometries must be invalidated before any other part is informed
+    Latte::Corona *latteCorona = qobject_cast<Latte::Corona *>(corona);
+
+    if (latteCorona) {
+        connect(this, &QWindow::xChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &QWindow::yChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &QWindow::widthChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &QWindow::heightChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &QWindow::screenChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::absoluteGeometryChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::activitiesChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::alignmentChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::behaveAsPlasmaPanelChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::containmentChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::layoutChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::maxLengthChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::normalThicknessChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::offsetChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::screenEdgeMarginChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::screenEdgeMarginEnabledChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &View::visibilityChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this, &QObject::destroyed, latteCorona, &Latte::Corona::invalidateAvailableScreenGeometries);
+    }
+
     //! needs to be created after Effects because it catches some of its signals
     //! and avoid a crash from View::winId() at the same time
     m_positioner = new ViewPart::Positioner(this);
@@ -138,6 +167,14 @@ View::View(Plasma::Corona *corona, QScreen *targetScreen, bool byPassWM)
         if (!m_visibility) {
             m_visibility = new ViewPart::VisibilityManager(this);
 
+            //! the view mode is now taken into account for the available screen geometries
+            if (m_corona) {
+                m_corona->invalidateAvailableScreenGeometries();
+            }
+
+            connect(m_visibility, &ViewPart::VisibilityManager::modeChanged, m_corona, &Latte::Corona::invalidateAvailableScreenGeometries);
+            connect(m_visibility, &QObject::destroyed, m_corona, &Latte::Corona::invalidateAvailableScreenGeometries);
+
             connect(m_visibility, &ViewPart::VisibilityManager::isHiddenChanged, this, [&]() {
                 if (m_visibility->isHidden()) {
                     m_interface->deactivateApplets();
@@ -174,6 +211,8 @@ View::View(Plasma::Corona *corona, QScreen *targetScreen, bool byPassWM)
         }
 
         connect(this->containment(), SIGNAL(statusChanged(Plasma::Types::ItemStatus)), SLOT(statusChanged(Plasma::Types::ItemStatus)));
+        connect(this->containment(), &Plasma::Applet::formFactorChanged, m_corona, &Latte::Corona::invalidateAvailableScreenGeometries);
+        connect(this->containment(), &Plasma::Applet::locationChanged, m_corona, &Latte::Corona::invalidateAvailableScreenGeometries);
         connect(this->containment(), &Plasma::Containment::userConfiguringChanged, this, [&]() {
             emit inEditModeChanged();
         });
@@ -1326,10 +1365,59 @@ void View::setInterfacesGraphicObj(Latte::Interfaces *ifaces)
     emit interfacesGraphicObjChanged();
 }
 
+void View::subscribeToEvents(const QList<QEvent::Type> &types)
+{
+    for (const auto type : types) {
+        m_eventSubscriptions[type] = m_eventSubscriptions.value(type, 0) + 1;
+    }
+}
+
+void View::unsubscribeFromEvents(const QList<QEvent::Type> &types)
+{
+    for (const auto type : types) {
+        if (!m_eventSubscriptions.contains(type)) {
+            continue;
+        }
+
+        if (m_eventSubscriptions[type] <= 1) {
+            m_eventSubscriptions.remove(type);
+        } else {
+            m_eventSubscriptions[type]--;
+        }
+    }
+}
+
 bool View::event(QEvent *e)
 {   
     if (!m_inDelete) {
-        emit eventTriggered(e);
+        const bool reportEvents = LATTE_VIEW_EVENTS().isDebugEnabled();
+
+        if (reportEvents) {
+            if (!m_eventsElapsed.isValid()) {
+                m_eventsElapsed.start();
+            }
+
+            m_eventsReceived++;
+        }
+
+        //! avoid signal marshalling for the plenty of events that nobody is interested in,
+        //! e.g. mouse/hover moves and update requests during parabolic zoom
+        if (m_eventSubscriptions.contains(e->type())) {
+            if (reportEvents) {
+                m_eventsDispatched++;
+            }
+
+            emit eventTriggered(e);
+        }
+
+        if (reportEvents && m_eventsElapsed.elapsed() >= 1000) {
+            qCDebug(LATTE_VIEW_EVENTS) << "View events per second :: " << (containment() ? containment()->id() : 0)
+                                       << " received: " << m_eventsReceived << ", dispatched: " << m_eventsDispatched;
+
+            m_eventsReceived = 0;
+            m_eventsDispatched = 0;
+            m_eventsElapsed.restart();
+        }
 
         switch (e->type()) {
         case QEvent::Enter:
@@ -39,6 +39,9 @@
 #include <array>
 
 // Qt
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QHash>
 #include <QQuickView>
 #include <QMenu>
 #include <QMetaObject>
@@ -259,6 +262,10 @@ public:
     //! used from ViewSettingsFactory in order to move Configuration Windows to different View
     void releaseConfigView();
 
+    //! eventTriggered() is emitted only for the event types that have been subscribed
+    void subscribeToEvents(const QList<QEvent::Type> &types);
+    void unsubscribeFromEvents(const QList<QEvent::Type> &types);
+
 public slots:
     Q_INVOKABLE void copyView();
     Q_INVOKABLE void removeView();
@@ -403,6 +410,14 @@ private:
 
     QStringList m_activities;
 
+    //! event type, subscriptions count
+    QHash<QEvent::Type, int> m_eventSubscriptions;
+
+    //! events received and events dispatched to subscribers during the last second
+    int m_eventsReceived{0};
+    int m_eventsDispatched{0};
+    QElapsedTimer m_eventsElapsed;
+
     //! HACK: In order to avoid crashes when the View is added and removed
     //! immediately during startup
     QTimer m_initLayoutTimer;
@@ -51,6 +51,8 @@ const int HIDEMINIMUMINTERVAL = 0;
 //! or global shortcuts we make sure bar will be shown enough time
 //! in order for the user to observe its contents
 const int SIDEBARAUTOHIDEMINIMUMSHOW = 1000;
+//! View events that are handled in viewEventManager
+const QList<QEvent::Type> VIEWEVENTS = {QEvent::Enter, QEvent::Leave, QEvent::DragEnter, QEvent::DragLeave, QEvent::Drop};
 
 
 namespace Latte {
@@ -84,6 +86,7 @@ VisibilityManager::VisibilityManager(PlasmaQuick::ContainmentView *view)
     });
 
     if (m_latteView) {
+        m_latteView->subscribeToEvents(VIEWEVENTS);
         connect(m_latteView, &Latte::View::eventTriggered, this, &VisibilityManager::viewEventManager);
         connect(m_latteView, &Latte::View::behaveAsPlasmaPanelChanged , this, &VisibilityManager::updateFloatingGapWindow);
         connect(m_latteView, &Latte::View::behaveAsPlasmaPanelChanged , this, &VisibilityManager::updateKWinEdgesSupport);
@@ -169,6 +172,10 @@ VisibilityManager::~VisibilityManager()
     qDebug() << "VisibilityManager deleting...";
     m_wm->removeViewStruts(*m_latteView);
 
+    if (m_latteView) {
+        m_latteView->unsubscribeFromEvents(VIEWEVENTS);
+    }
+
     if (m_edgeGhostWindow) {
         m_edgeGhostWindow->deleteLater();
     }
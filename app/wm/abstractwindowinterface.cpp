@@ -36,6 +36,8 @@ namespace WindowSystem {
 
 #define MAXPLASMAPANELTHICKNESS 96
 #define MAXSIDEPANELTHICKNESS 512
+//! windows changes are never delayed more than that time
+#define MAXWINDOWWAITINGTIME 600
 
 AbstractWindowInterface::AbstractWindowInterface(QObject *parent)
     : QObject(parent)
@@ -52,11 +54,7 @@ AbstractWindowInterface::AbstractWindowInterface(QObject *parent)
     m_windowWaitingTimer.setInterval(150);
     m_windowWaitingTimer.setSingleShot(true);
 
-    connect(&m_windowWaitingTimer, &QTimer::timeout, this, [&]() {
-        WindowId wid = m_windowChangedWaiting;
-        m_windowChangedWaiting = QVariant();
-        emit windowChanged(wid);
-    });
+    connect(&m_windowWaitingTimer, &QTimer::timeout, this, &AbstractWindowInterface::sendWindowsChangedWaiting);
 
     connect(this, &AbstractWindowInterface::windowRemoved, this, &AbstractWindowInterface::windowRemovedSlot);
 
@@ -249,6 +247,8 @@ void AbstractWindowInterface::unregisterWhitelistedWindow(WindowId wid)
 
 void AbstractWindowInterface::windowRemovedSlot(WindowId wid)
 {
+    m_windowsChangedWaiting.removeAll(wid);
+
     if (m_plasmaIgnoredWindows.contains(wid)) {
         unregisterPlasmaIgnoredWindow(wid);
     }
@@ -302,29 +302,33 @@ void AbstractWindowInterface::switchToPreviousActivity()
 //! Delay window changed trigerring
 void AbstractWindowInterface::considerWindowChanged(WindowId wid)
 {
-    //! Consider if the windowChanged signal should be sent DIRECTLY or WAIT
+    //! Coalesce the changed windows in order to be sent afterwards as one batch
 
-    if (m_windowChangedWaiting == wid && m_windowWaitingTimer.isActive()) {
-        //! window should be sent later
-        m_windowWaitingTimer.start();
-        return;
+    if (!m_windowsChangedWaiting.contains(wid)) {
+        m_windowsChangedWaiting.append(wid);
     }
 
-    if (m_windowChangedWaiting != wid && !m_windowWaitingTimer.isActive()) {
-        //! window should be sent later
-        m_windowChangedWaiting = wid;
+    if (!m_windowWaitingTimer.isActive()) {
+        m_windowWaitingElapsed.start();
+        m_windowWaitingTimer.start();
+    } else if (m_windowWaitingElapsed.elapsed() < MAXWINDOWWAITINGTIME) {
+        //! windows are still changing, wait for them to settle
         m_windowWaitingTimer.start();
     }
+}
 
-    if (m_windowChangedWaiting != wid && m_windowWaitingTimer.isActive()) {
-        m_windowWaitingTimer.stop();
-        //! sent previous waiting window
-        emit windowChanged(m_windowChangedWaiting);
+void AbstractWindowInterface::sendWindowsChangedWaiting()
+{
+    m_windowWaitingTimer.stop();
 
-        //! retrigger waiting for the upcoming window
-        m_windowChangedWaiting = wid;
-        m_windowWaitingTimer.start();
+    if (m_windowsChangedWaiting.isEmpty()) {
+        return;
     }
+
+    QList<WindowId> wids = m_windowsChangedWaiting;
+    m_windowsChangedWaiting.clear();
+
+    emit windowsChanged(wids);
 }
 
 }
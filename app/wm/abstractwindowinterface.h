@@ -36,6 +36,7 @@
 #include <QObject>
 #include <QWindow>
 #include <QDialog>
+#include <QElapsedTimer>
 #include <QMap>
 #include <QRect>
 #include <QPoint>
@@ -147,6 +148,8 @@ public:
 signals:
     void activeWindowChanged(WindowId wid);
     void windowChanged(WindowId winfo);
+    //! windows that changed during the last window changes tick
+    void windowsChanged(const QList<WindowId> &wids);
     void windowAdded(WindowId wid);
     void windowRemoved(WindowId wid);
     void currentDesktopChanged();
@@ -169,11 +172,13 @@ protected:
 
     QPointer<KActivities::Consumer> m_activities;
 
-    //! Sending too fast plenty of signals for the same window
+    //! Sending too fast plenty of signals for the same windows
     //! has no reason and can create HIGH CPU usage. This Timer
-    //! can delay the batch sending of signals for the same window
-    WindowId m_windowChangedWaiting;
+    //! can delay and coalesce the changed windows in order to be
+    //! sent afterwards as one batch
+    QList<WindowId> m_windowsChangedWaiting;
     QTimer m_windowWaitingTimer;
+    QElapsedTimer m_windowWaitingElapsed;
 
     //! Plasma taskmanager rules ile
     KSharedConfig::Ptr rulesConfig;
@@ -190,6 +195,7 @@ protected:
 
 private slots:
     void windowRemovedSlot(WindowId wid);
+    void sendWindowsChangedWaiting();
 
 private:
     Latte::Corona *m_corona;
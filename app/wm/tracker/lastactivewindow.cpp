@@ -55,7 +55,7 @@ LastActiveWindow::LastActiveWindow(TrackedGeneralInfo *trackedInfo)
     });
 
     connect(m_windowsTracker, &Windows::applicationDataChanged, this, &LastActiveWindow::applicationDataChanged);
-    connect(m_windowsTracker, &Windows::windowChanged, this, &LastActiveWindow::windowChanged);
+    connect(m_windowsTracker, &Windows::windowsChanged, this, &LastActiveWindow::windowsChanged);
     connect(m_windowsTracker, &Windows::windowRemoved, this, &LastActiveWindow::windowRemoved);
 }
 
@@ -548,6 +548,44 @@ void LastActiveWindow::windowChanged(const WindowId &wid)
     }
 }
 
+void LastActiveWindow::windowsChanged(const QList<WindowId> &wids)
+{
+    if (!m_trackedInfo->enabled()) {
+        return;
+    }
+
+    bool firstItemChanged{false};
+
+    for (const auto &wid : wids) {
+        if (!m_history.contains(wid)) {
+            continue;
+        }
+
+        if (m_history[0] == wid) {
+            firstItemChanged = true;
+        }
+
+        WindowInfoWrap winfo = m_windowsTracker->infoFor(wid);
+
+        //! Remove minimized windows OR NOT-TRACKED windows from history
+        if (winfo.isMinimized() || !m_trackedInfo->isTracking(winfo)) {
+            m_history.removeAll(wid);
+        }
+    }
+
+    cleanHistory();
+
+    //! update information only once for the whole batch
+    if (firstItemChanged) {
+        if (m_history.count() > 0) {
+            windowChanged(m_history[0]);
+        } else {
+            //! History is empty so any demonstrated information are invalid
+            setIsValid(false);
+        }
+    }
+}
+
 void LastActiveWindow::windowRemoved(const WindowId &wid)
 {
     if (m_history.contains(wid)) {
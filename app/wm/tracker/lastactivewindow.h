@@ -134,6 +134,7 @@ private slots:
     void applicationDataChanged(const WindowId &wid);
 
     void windowChanged(const WindowId &wid);
+    void windowsChanged(const QList<WindowId> &wids);
     void windowRemoved(const WindowId &wid);
 
 
@@ -0,0 +1,119 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "screenedgesindex.h"
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+void ScreenEdgesIndex::updateView(Latte::View *view, const int screenId, const QRect &screenGeometry,
+                                  const QRect &availableScreenGeometry, const QRect &absoluteGeometry)
+{
+    if (!view) {
+        return;
+    }
+
+    if (m_entries.contains(view) && m_entries[view].screenId != screenId) {
+        removeView(view);
+    }
+
+    ViewEntry &entry = m_entries[view];
+    entry.screenId = screenId;
+    entry.availableScreenGeometry = availableScreenGeometry;
+    //! a window is touching the view edge when it is found one pixel outside the view
+    entry.edgeStrip = absoluteGeometry.isValid() ? absoluteGeometry.adjusted(-1, -1, 1, 1) : QRect();
+
+    m_screens[screenId] = screenGeometry.adjusted(-1, -1, 1, 1);
+
+    if (!m_screenViews[screenId].contains(view)) {
+        m_screenViews[screenId].append(view);
+    }
+}
+
+void ScreenEdgesIndex::removeView(Latte::View *view)
+{
+    if (!m_entries.contains(view)) {
+        return;
+    }
+
+    int screenId = m_entries.take(view).screenId;
+
+    m_screenViews[screenId].removeAll(view);
+
+    if (m_screenViews[screenId].isEmpty()) {
+        m_screenViews.remove(screenId);
+        m_screens.remove(screenId);
+    }
+}
+
+bool ScreenEdgesIndex::contains(Latte::View *view) const
+{
+    return m_entries.contains(view);
+}
+
+void ScreenEdgesIndex::collectViewsAt(const QRect &geometry, QList<Latte::View *> &views) const
+{
+    if (!geometry.isValid()) {
+        return;
+    }
+
+    QPoint center = geometry.center();
+
+    for (QHash<int, QRect>::const_iterator screen=m_screens.constBegin(); screen!=m_screens.constEnd(); ++screen) {
+        if (!screen.value().intersects(geometry)) {
+            continue;
+        }
+
+        for (const auto view : m_screenViews[screen.key()]) {
+            if (views.contains(view)) {
+                continue;
+            }
+
+            const ViewEntry &entry = m_entries[view];
+
+            if (entry.availableScreenGeometry.contains(center) || entry.edgeStrip.intersects(geometry)) {
+                views << view;
+            }
+        }
+    }
+}
+
+QList<Latte::View *> ScreenEdgesIndex::viewsAt(const QRect &geometry) const
+{
+    QList<Latte::View *> views;
+    collectViewsAt(geometry, views);
+    return views;
+}
+
+QList<Latte::View *> ScreenEdgesIndex::viewsAt(const QRect &previous, const QRect &current) const
+{
+    QList<Latte::View *> views;
+    collectViewsAt(previous, views);
+
+    if (current != previous) {
+        collectViewsAt(current, views);
+    }
+
+    return views;
+}
+
+}
+}
+}
@@ -0,0 +1,78 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMSCREENEDGESINDEX_H
+#define WINDOWSYSTEMSCREENEDGESINDEX_H
+
+// Qt
+#include <QHash>
+#include <QList>
+#include <QRect>
+
+namespace Latte {
+class View;
+}
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Spatial index of the tracked views per screen. Each view is registered with
+//! its available screen geometry, that is used for the active/maximized window
+//! criteria, and its edge strip, the view absolute geometry grown by one pixel
+//! that is used for the touching and edge touching criteria. It is used in order
+//! to re-evaluate only the views that a window change can really affect.
+class ScreenEdgesIndex
+{
+public:
+    void updateView(Latte::View *view, const int screenId, const QRect &screenGeometry,
+                    const QRect &availableScreenGeometry, const QRect &absoluteGeometry);
+    void removeView(Latte::View *view);
+
+    bool contains(Latte::View *view) const;
+
+    //! views that are affected from a window that is/was present at geometry
+    QList<Latte::View *> viewsAt(const QRect &geometry) const;
+    //! views that are affected from a window that moved from previous to current geometry
+    QList<Latte::View *> viewsAt(const QRect &previous, const QRect &current) const;
+
+private:
+    struct ViewEntry {
+        int screenId{-1};
+        QRect availableScreenGeometry;
+        QRect edgeStrip;
+    };
+
+    void collectViewsAt(const QRect &geometry, QList<Latte::View *> &views) const;
+
+private:
+    QHash<Latte::View *, ViewEntry> m_entries;
+
+    //! screen id -> screen geometry grown by one pixel, in order to catch edge strips
+    //! that are found just at the screen boundaries
+    QHash<int, QRect> m_screens;
+    //! screen id -> views present in that screen
+    QHash<int, QList<Latte::View *>> m_screenViews;
+};
+
+}
+}
+}
+
+#endif
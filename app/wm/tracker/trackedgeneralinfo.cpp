@@ -117,9 +117,16 @@ bool TrackedGeneralInfo::isTrackingCurrentActivity() const
 
 void TrackedGeneralInfo::updateTrackingCurrentActivity()
 {
-    m_isTrackingCurrentActivity = ( m_activities.isEmpty()
-                                    || m_activities[0] == "0"
+    bool isTracking = ( m_activities.isEmpty()
+                        || m_activities[0] == "0"
             || m_activities.contains(m_wm->currentActivity()));
+
+    if (m_isTrackingCurrentActivity == isTracking) {
+        return;
+    }
+
+    m_isTrackingCurrentActivity = isTracking;
+    emit isTrackingCurrentActivityChanged();
 }
 
 
@@ -152,6 +159,46 @@ void TrackedGeneralInfo::setActiveWindow(const WindowId &wid)
     m_lastActiveWindow->setInformation(m_tracker->infoFor(wid));
 }
 
+QList<WindowId> TrackedGeneralInfo::activeWindows() const
+{
+    return m_activeWindows;
+}
+
+void TrackedGeneralInfo::setIsActiveWindow(const WindowId &wid, bool active)
+{
+    updateWindowsList(m_activeWindows, wid, active);
+}
+
+QList<WindowId> TrackedGeneralInfo::maximizedWindows() const
+{
+    return m_maximizedWindows;
+}
+
+void TrackedGeneralInfo::setIsMaximizedWindow(const WindowId &wid, bool maximized)
+{
+    updateWindowsList(m_maximizedWindows, wid, maximized);
+}
+
+bool TrackedGeneralInfo::containsWindow(const WindowId &wid) const
+{
+    return m_activeWindows.contains(wid) || m_maximizedWindows.contains(wid);
+}
+
+void TrackedGeneralInfo::clearWindows()
+{
+    m_activeWindows.clear();
+    m_maximizedWindows.clear();
+}
+
+void TrackedGeneralInfo::updateWindowsList(QList<WindowId> &windows, const WindowId &wid, bool contained)
+{
+    if (!contained) {
+        windows.removeAll(wid);
+    } else if (!windows.contains(wid)) {
+        windows.append(wid);
+    }
+}
+
 bool TrackedGeneralInfo::isTracking(const WindowInfoWrap &winfo) const
 {
     return (winfo.isValid()
@@ -73,14 +73,28 @@ public:
 
     void setActiveWindow(const WindowId &wid);
 
+    //! windows that are currently fulfilling the active and maximized criteria,
+    //! they are updated incrementally from each window change
+    QList<WindowId> activeWindows() const;
+    void setIsActiveWindow(const WindowId &wid, bool active);
+
+    QList<WindowId> maximizedWindows() const;
+    void setIsMaximizedWindow(const WindowId &wid, bool maximized);
+
+    virtual bool containsWindow(const WindowId &wid) const;
+    virtual void clearWindows();
+
     virtual bool isTracking(const WindowInfoWrap &winfo) const;
 
 signals:
+    void isTrackingCurrentActivityChanged();
     void lastActiveWindowChanged();
 
 protected:
     void updateTrackingCurrentActivity();
 
+    static void updateWindowsList(QList<WindowId> &windows, const WindowId &wid, bool contained);
+
 protected:
     QStringList m_activities;
 
@@ -89,14 +103,17 @@ protected:
     Tracker::Windows *m_tracker{nullptr};
 
 private:
-    bool m_enabled;
-    bool m_activeWindowMaximized;
-    bool m_existsWindowActive;
-    bool m_existsWindowMaximized;
+    bool m_enabled{false};
+    bool m_activeWindowMaximized{false};
+    bool m_existsWindowActive{false};
+    bool m_existsWindowMaximized{false};
 
     bool m_isTrackingCurrentActivity{true};
 
     SchemeColors *m_activeWindowScheme{nullptr};
+
+    QList<WindowId> m_activeWindows;
+    QList<WindowId> m_maximizedWindows;
 };
 
 }
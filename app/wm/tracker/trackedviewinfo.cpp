@@ -149,6 +149,41 @@ Latte::View *TrackedViewInfo::view() const
     return m_view;
 }
 
+QList<WindowId> TrackedViewInfo::touchingWindows() const
+{
+    return m_touchingWindows;
+}
+
+void TrackedViewInfo::setIsTouchingWindow(const WindowId &wid, bool touching)
+{
+    updateWindowsList(m_touchingWindows, wid, touching);
+}
+
+QList<WindowId> TrackedViewInfo::touchingEdgeWindows() const
+{
+    return m_touchingEdgeWindows;
+}
+
+void TrackedViewInfo::setIsTouchingEdgeWindow(const WindowId &wid, bool touching)
+{
+    updateWindowsList(m_touchingEdgeWindows, wid, touching);
+}
+
+bool TrackedViewInfo::containsWindow(const WindowId &wid) const
+{
+    return TrackedGeneralInfo::containsWindow(wid)
+            || m_touchingWindows.contains(wid)
+            || m_touchingEdgeWindows.contains(wid);
+}
+
+void TrackedViewInfo::clearWindows()
+{
+    TrackedGeneralInfo::clearWindows();
+
+    m_touchingWindows.clear();
+    m_touchingEdgeWindows.clear();
+}
+
 bool TrackedViewInfo::isTracking(const WindowInfoWrap &winfo) const
 {   
     return  TrackedGeneralInfo::isTracking(winfo)
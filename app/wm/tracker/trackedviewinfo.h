@@ -73,6 +73,15 @@ public:
 
     Latte::View *view() const;
 
+    QList<WindowId> touchingWindows() const;
+    void setIsTouchingWindow(const WindowId &wid, bool touching);
+
+    QList<WindowId> touchingEdgeWindows() const;
+    void setIsTouchingEdgeWindow(const WindowId &wid, bool touching);
+
+    bool containsWindow(const WindowId &wid) const override;
+    void clearWindows() override;
+
     bool isTracking(const WindowInfoWrap &winfo) const override;
 
 private:
@@ -86,6 +95,9 @@ private:
 
     SchemeColors *m_touchingWindowScheme{nullptr};
 
+    QList<WindowId> m_touchingWindows;
+    QList<WindowId> m_touchingEdgeWindows;
+
     Latte::View *m_view{nullptr};
 };
 
@@ -79,20 +79,20 @@ void Windows::init()
     connect(m_wm->corona(), &Plasma::Corona::availableScreenRectChanged, this, &Windows::updateAvailableScreenGeometries);
 
     connect(m_wm, &AbstractWindowInterface::windowChanged, this, [&](WindowId wid) {
-        m_windows[wid] = m_wm->requestInfo(wid);
-        updateAllHints();
-
-        emit windowChanged(wid);
+        updateWindows({wid});
     });
 
+    connect(m_wm, &AbstractWindowInterface::windowsChanged, this, &Windows::updateWindows);
+
     connect(m_wm, &AbstractWindowInterface::windowRemoved, this, [&](WindowId wid) {
+        QRect previousGeometry = m_windows.contains(wid) ? m_windows[wid].geometry() : QRect();
         m_windows.remove(wid);
 
         //! application data
         m_initializedApplicationData.removeAll(wid);
         m_delayedApplicationData.removeAll(wid);
 
-        updateAllHints();
+        updateAffectedHints({wid}, m_screenEdgesIndex.viewsAt(previousGeometry));
 
         emit windowRemoved(wid);
     });
@@ -101,21 +101,27 @@ void Windows::init()
         if (!m_windows.contains(wid)) {
             m_windows.insert(wid, m_wm->requestInfo(wid));
         }
-        updateAllHints();
+        updateAffectedHints({wid}, m_screenEdgesIndex.viewsAt(m_windows[wid].geometry()));
     });
 
     connect(m_wm, &AbstractWindowInterface::activeWindowChanged, this, [&](WindowId wid) {
+        QList<WindowId> changedWindows;
+        QList<Latte::View *> affectedViews;
+
         //! for some reason this is needed in order to update properly activeness values
         //! when the active window changes the previous active windows should be also updated
         for (const auto view : m_views.keys()) {
             WindowId lastWinId = m_views[view]->lastActiveWindow()->winId();
-            if ((lastWinId) != wid && m_windows.contains(lastWinId)) {
-                m_windows[lastWinId] = m_wm->requestInfo(lastWinId);
+            if ((lastWinId) != wid && m_windows.contains(lastWinId) && !changedWindows.contains(lastWinId)) {
+                updateWindowInfo(lastWinId, affectedViews);
+                changedWindows << lastWinId;
             }
         }
 
-        m_windows[wid] = m_wm->requestInfo(wid);
-        updateAllHints();
+        updateWindowInfo(wid, affectedViews);
+        changedWindows << wid;
+
+        updateAffectedHints(changedWindows, affectedViews);
 
         emit activeWindowChanged(wid);
     });
@@ -179,7 +185,12 @@ void Windows::addView(Latte::View *view)
 
     m_views[view] = new TrackedViewInfo(this, view);
 
+    connect(m_views[view], &TrackedGeneralInfo::isTrackingCurrentActivityChanged, this, [&, view]() {
+        updateHints(view);
+    });
+
     updateAvailableScreenGeometries();
+    updateScreenEdgesIndex(view);
 
     //! Consider Layouts
     addRelevantLayout(view);
@@ -191,6 +202,18 @@ void Windows::addView(Latte::View *view)
     connect(view, &Latte::View::isTouchingBottomViewAndIsBusyChanged, this, &Windows::updateExtraViewHints);
     connect(view, &Latte::View::isTouchingTopViewAndIsBusyChanged, this, &Windows::updateExtraViewHints);
 
+    //! views that move must be re-evaluated because window events are checked
+    //! only against the views they are affecting
+    connect(view, &Latte::View::absoluteGeometryChanged, this, [&, view]() {
+        updateScreenEdgesIndex(view);
+        updateHints(view);
+    });
+
+    connect(view, &Latte::View::screenGeometryChanged, this, [&, view]() {
+        updateScreenEdgesIndex(view);
+        updateHints(view);
+    });
+
     updateAllHints();
 
     emit informationAnnounced(view);
@@ -205,6 +228,8 @@ void Windows::removeView(Latte::View *view)
     m_views[view]->deleteLater();
     m_views.remove(view);
 
+    m_screenEdgesIndex.removeView(view);
+
     updateRelevantLayouts();
 }
 
@@ -215,7 +240,12 @@ void Windows::addRelevantLayout(Latte::View *view)
 
         if (!m_layouts.contains(view->layout())) {
             initializing = true;
-            m_layouts[view->layout()] = new TrackedLayoutInfo(this, view->layout());
+            Latte::Layout::GenericLayout *layout = view->layout();
+            m_layouts[layout] = new TrackedLayoutInfo(this, layout);
+
+            connect(m_layouts[layout], &TrackedGeneralInfo::isTrackingCurrentActivityChanged, this, [&, layout]() {
+                updateHints(layout);
+            });
         }
 
         //! Update always the AllScreens tracking because there is a chance a view delayed to be assigned in a layout
@@ -267,10 +297,13 @@ void Windows::updateRelevantLayouts()
         }
 
         if (i.value()) {
+            bool wasEnabled = i.value()->enabled();
             i.value()->setEnabled(hasViewEnabled);
 
             if (!hasViewEnabled) {
                 initLayoutHints(i.key());
+            } else if (!wasEnabled) {
+                updateHints(i.key());
             }
         }
     }
@@ -784,15 +817,36 @@ bool Windows::isTouchingViewEdge(Latte::View *view, const WindowInfoWrap &winfo)
     return false;
 }
 
+bool Windows::isFaultyWindow(const WindowInfoWrap &winfo) const
+{
+    return (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0));
+}
+
+bool Windows::isTrackedWindow(const WindowInfoWrap &winfo)
+{
+    return (m_wm->inCurrentDesktopActivity(winfo)
+            && !m_wm->hasBlockedTracking(winfo.wid())
+            && !winfo.isMinimized());
+}
+
 void Windows::cleanupFaultyWindows()
 {
     for (const auto &key : m_windows.keys()) {
         auto winfo = m_windows[key];
 
         //! garbage windows removing
-        if (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0)) {
+        if (isFaultyWindow(winfo)) {
             //qDebug() << "Faulty Geometry ::: " << winfo.wid();
             m_windows.remove(key);
+
+            //! release the window from all incremental windows lists
+            for (QHash<Latte::View *, TrackedViewInfo *>::iterator i=m_views.begin(); i!=m_views.end(); ++i) {
+                updateWindowHints(i.key(), key, WindowInfoWrap());
+            }
+
+            for (QHash<Latte::Layout::GenericLayout *, TrackedLayoutInfo *>::iterator i=m_layouts.begin(); i!=m_layouts.end(); ++i) {
+                updateWindowHints(i.key(), key, WindowInfoWrap());
+            }
         }
     }
 }
@@ -809,6 +863,7 @@ void Windows::updateAvailableScreenGeometries()
 
             if (tempAvailableScreenGeometry != m_views[view]->availableScreenGeometry()) {
                 m_views[view]->setAvailableScreenGeometry(tempAvailableScreenGeometry);
+                updateScreenEdgesIndex(view);
                 updateHints(view);
             }
         }
@@ -830,6 +885,92 @@ void Windows::updateAllHints()
     }
 }
 
+void Windows::updateWindowInfo(const WindowId &wid, QList<Latte::View *> &affectedViews)
+{
+    QRect previousGeometry = m_windows.contains(wid) ? m_windows[wid].geometry() : QRect();
+    m_windows[wid] = m_wm->requestInfo(wid);
+
+    for (const auto view : m_screenEdgesIndex.viewsAt(previousGeometry, m_windows[wid].geometry())) {
+        if (!affectedViews.contains(view)) {
+            affectedViews << view;
+        }
+    }
+}
+
+void Windows::updateWindows(const QList<WindowId> &wids)
+{
+    QList<Latte::View *> affectedViews;
+
+    for (const auto &wid : wids) {
+        updateWindowInfo(wid, affectedViews);
+    }
+
+    updateAffectedHints(wids, affectedViews);
+
+    emit windowsChanged(wids);
+}
+
+void Windows::updateAffectedHints(const QList<WindowId> &windows, const QList<Latte::View *> &views)
+{
+    QList<Latte::View *> affectedViews = views;
+
+    for (const auto &wid : windows) {
+        //! garbage windows removing
+        if (m_windows.contains(wid) && isFaultyWindow(m_windows[wid])) {
+            m_windows.remove(wid);
+        }
+
+        //! views that were already counting the window must always release it
+        for (QHash<Latte::View *, TrackedViewInfo *>::iterator i=m_views.begin(); i!=m_views.end(); ++i) {
+            if (!affectedViews.contains(i.key()) && i.value()->containsWindow(wid)) {
+                affectedViews << i.key();
+            }
+        }
+    }
+
+    for (const auto view : affectedViews) {
+        if (!m_views.contains(view) || !m_views[view]->enabled() || !m_views[view]->isTrackingCurrentActivity()) {
+            continue;
+        }
+
+        for (const auto &wid : windows) {
+            updateWindowHints(view, wid, m_windows.value(wid));
+        }
+
+        applyHints(view);
+    }
+
+    //! layouts are tracking windows in all screens
+    for (QHash<Latte::Layout::GenericLayout *, TrackedLayoutInfo *>::iterator i=m_layouts.begin(); i!=m_layouts.end(); ++i) {
+        if (!i.value() || !i.value()->enabled() || !i.value()->isTrackingCurrentActivity()) {
+            continue;
+        }
+
+        for (const auto &wid : windows) {
+            updateWindowHints(i.key(), wid, m_windows.value(wid));
+        }
+
+        applyHints(i.key());
+    }
+
+    if (!m_extraViewHintsTimer.isActive()) {
+        m_extraViewHintsTimer.start();
+    }
+}
+
+void Windows::updateScreenEdgesIndex(Latte::View *view)
+{
+    if (!m_views.contains(view)) {
+        return;
+    }
+
+    m_screenEdgesIndex.updateView(view,
+                                  view->positioner()->currentScreenId(),
+                                  view->screenGeometry(),
+                                  m_views[view]->availableScreenGeometry(),
+                                  view->absoluteGeometry());
+}
+
 void Windows::updateExtraViewHints()
 {
     for (const auto horView : m_views.keys()) {
@@ -873,7 +1014,53 @@ void Windows::updateHints(Latte::View *view)
         return;
     }
 
-    bool foundActive{false};
+    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
+    //! maybe a garbage collector here is a good idea!!!
+    bool existsFaultyWindow{false};
+
+    //! full rescan, all windows lists are recreated from scratch
+    m_views[view]->clearWindows();
+
+    for (QMap<WindowId, WindowInfoWrap>::const_iterator i=m_windows.constBegin(); i!=m_windows.constEnd(); ++i) {
+        if (!existsFaultyWindow && isFaultyWindow(i.value())) {
+            existsFaultyWindow = true;
+        }
+
+        updateWindowHints(view, i.key(), i.value());
+    }
+
+    if (existsFaultyWindow) {
+        cleanupFaultyWindows();
+    }
+
+    applyHints(view);
+}
+
+void Windows::updateWindowHints(Latte::View *view, const WindowId &wid, const WindowInfoWrap &winfo)
+{
+    if (!m_views.contains(view)) {
+        return;
+    }
+
+    TrackedViewInfo *viewInfo = m_views[view];
+    bool tracked = isTrackedWindow(winfo);
+
+    //qDebug() << "TRACKING | WINDOW INFO :: " << winfo.wid() << " _ " << winfo.appName() << " _ " << winfo.geometry() << " _ " << winfo.display();
+
+    viewInfo->setIsActiveWindow(wid, tracked && isActiveInViewScreen(view, winfo));
+    viewInfo->setIsMaximizedWindow(wid, tracked && isMaximizedInViewScreen(view, winfo));
+    viewInfo->setIsTouchingWindow(wid, tracked && isTouchingView(view, winfo));
+    viewInfo->setIsTouchingEdgeWindow(wid, tracked && isTouchingViewEdge(view, winfo));
+}
+
+void Windows::applyHints(Latte::View *view)
+{
+    if (!m_views.contains(view) || !m_views[view]->enabled() || !m_views[view]->isTrackingCurrentActivity()) {
+        return;
+    }
+
+    TrackedViewInfo *viewInfo = m_views[view];
+
     bool foundActiveInCurScreen{false};
     bool foundActiveTouchInCurScreen{false};
     bool foundActiveEdgeTouchInCurScreen{false};
@@ -883,10 +1070,6 @@ void Windows::updateHints(Latte::View *view)
 
     bool foundActiveGroupTouchInCurScreen{false};
 
-    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
-    //! maybe a garbage collector here is a good idea!!!
-    bool existsFaultyWindow{false};
-
     WindowId maxWinId;
     WindowId activeWinId;
     WindowId touchWinId;
@@ -896,106 +1079,66 @@ void Windows::updateHints(Latte::View *view)
 
     //qDebug() << " -- TRACKING REPORT (SCREEN)--";
 
-    //! First Pass
-    for (const auto &winfo : m_windows) {
-        if (!existsFaultyWindow && (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0))) {
-            existsFaultyWindow = true;
-        }
-
-        if ( !m_wm->inCurrentDesktopActivity(winfo)
-             || m_wm->hasBlockedTracking(winfo.wid())
-             || winfo.isMinimized()) {
-            continue;
-        }
-
-        //qDebug() << " _ _ _ ";
-        //qDebug() << "TRACKING | WINDOW INFO :: " << winfo.wid() << " _ " << winfo.appName() << " _ " << winfo.geometry() << " _ " << winfo.display();
-
-        if (isActive(winfo)) {
-            foundActive = true;
-        }
+    QList<WindowId> activeWindows = viewInfo->activeWindows();
 
-        if (isActiveInViewScreen(view, winfo)) {
-            foundActiveInCurScreen = true;
-            activeWinId = winfo.wid();
-        }
+    if (!activeWindows.isEmpty()) {
+        //! the most recent window that became active
+        foundActiveInCurScreen = true;
+        activeWinId = activeWindows.last();
+    }
 
-        //! Maximized windows flags
-        if ((winfo.isActive() && isMaximizedInViewScreen(view, winfo)) //! active maximized windows have higher priority than the rest maximized windows
-                || (!foundMaximizedInCurScreen && isMaximizedInViewScreen(view, winfo))) {
+    //! Maximized windows flags
+    for (const auto &wid : viewInfo->maximizedWindows()) {
+        if (m_windows.value(wid).isActive()) {
+            //! active maximized windows have higher priority than the rest maximized windows
+            foundMaximizedInCurScreen = true;
+            maxWinId = wid;
+            break;
+        } else if (!foundMaximizedInCurScreen) {
             foundMaximizedInCurScreen = true;
-            maxWinId = winfo.wid();
+            maxWinId = wid;
         }
+    }
 
-        //! Touching windows flags
-
-        bool touchingViewEdge = isTouchingViewEdge(view, winfo);
-        bool touchingView =  isTouchingView(view, winfo);
+    //! Touching windows flags
+    QList<WindowId> touchingWindows = viewInfo->touchingWindows();
 
-        if (touchingView) {
-            if (winfo.isActive()) {
-                foundActiveTouchInCurScreen = true;
-                activeTouchWinId = winfo.wid();
-            } else {
-                foundTouchInCurScreen = true;
-                touchWinId = winfo.wid();
-            }
+    for (const auto &wid : touchingWindows) {
+        if (m_windows.value(wid).isActive()) {
+            foundActiveTouchInCurScreen = true;
+            activeTouchWinId = wid;
+        } else {
+            foundTouchInCurScreen = true;
+            touchWinId = wid;
         }
+    }
 
-        if (touchingViewEdge) {
-            if (winfo.isActive()) {
-                foundActiveEdgeTouchInCurScreen = true;
-                activeTouchEdgeWinId = winfo.wid();
-            } else {
-                foundTouchEdgeInCurScreen = true;
-                touchEdgeWinId = winfo.wid();
-            }
+    for (const auto &wid : viewInfo->touchingEdgeWindows()) {
+        if (m_windows.value(wid).isActive()) {
+            foundActiveEdgeTouchInCurScreen = true;
+            activeTouchEdgeWinId = wid;
+        } else {
+            foundTouchEdgeInCurScreen = true;
+            touchEdgeWinId = wid;
         }
-
-        //qDebug() << "TRACKING |       ACTIVE:"<< foundActive <<  " ACT_CUR_SCR:" << foundTouchInCurScreen << " MAXIM:"<<foundMaximizedInCurScreen;
-        //qDebug() << "TRACKING |       TOUCHING VIEW EDGE:"<< touchingViewEdge << " TOUCHING VIEW:" << foundTouchInCurScreen;
     }
 
-    if (existsFaultyWindow) {
-        cleanupFaultyWindows();
-    }
+    //qDebug() << "TRACKING |       ACTIVE:"<< foundActiveInCurScreen <<  " TOUCH_CUR_SCR:" << foundTouchInCurScreen << " MAXIM:"<<foundMaximizedInCurScreen;
 
-    //! PASS 2
     if (foundActiveInCurScreen && !foundActiveTouchInCurScreen) {
-        //! Second Pass to track also Child windows if needed
-
-        //qDebug() << "Windows Array...";
-        //for (const auto &winfo : m_windows) {
-        //    qDebug() << " - " << winfo.wid() << " - " << winfo.isValid() << " - " << winfo.display() << " - " << winfo.geometry() << " parent : " << winfo.parentId();
-        //}
-        //qDebug() << " - - - - - ";
-
-        WindowInfoWrap activeInfo = m_windows[activeWinId];
+        //! Track also Child windows if needed, consider only windows that belong
+        //! to active window group meaning the main window and its children
+        WindowInfoWrap activeInfo = m_windows.value(activeWinId);
         WindowId mainWindowId = activeInfo.isChildWindow() ? activeInfo.parentId() : activeWinId;
 
-        for (const auto &winfo : m_windows) {
-            if (!m_wm->inCurrentDesktopActivity(winfo)
-                    || m_wm->hasBlockedTracking(winfo.wid())
-                    || winfo.isMinimized()) {
-                continue;
-            }
-
-            bool inActiveGroup = (winfo.wid() == mainWindowId || winfo.parentId() == mainWindowId);
-
-            //! consider only windows that belong to active window group meaning the main window
-            //! and its children
-            if (!inActiveGroup) {
-                continue;
-            }
-
-            if (isTouchingView(view, winfo)) {
+        for (const auto &wid : touchingWindows) {
+            if (wid == mainWindowId || m_windows.value(wid).parentId() == mainWindowId) {
                 foundActiveGroupTouchInCurScreen = true;
                 break;
             }
         }
     }
 
-
     //! HACK: KWin Effects such as ShowDesktop have no way to be identified and as such
     //! create issues with identifying properly touching and maximized windows. BUT when
     //! they are enabled then NO ACTIVE window is found. This is a way to identify these
@@ -1052,50 +1195,62 @@ void Windows::updateHints(Latte::Layout::GenericLayout *layout) {
         return;
     }
 
-    bool foundActive{false};
-    bool foundActiveMaximized{false};
-    bool foundMaximized{false};
-
     //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
     //! maybe a garbage collector here is a good idea!!!
     bool existsFaultyWindow{false};
 
-    WindowId activeWinId;
-    WindowId maxWinId;
+    //! full rescan, all windows lists are recreated from scratch
+    m_layouts[layout]->clearWindows();
 
-    for (const auto &winfo : m_windows) {
-        if (!existsFaultyWindow && (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0))) {
+    for (QMap<WindowId, WindowInfoWrap>::const_iterator i=m_windows.constBegin(); i!=m_windows.constEnd(); ++i) {
+        if (!existsFaultyWindow && isFaultyWindow(i.value())) {
             existsFaultyWindow = true;
         }
 
-        if (!m_wm->inCurrentDesktopActivity(winfo)
-                || m_wm->hasBlockedTracking(winfo.wid())
-                || winfo.isMinimized()) {
-            continue;
-        }
+        updateWindowHints(layout, i.key(), i.value());
+    }
 
-        if (isActive(winfo)) {
-            foundActive = true;
-            activeWinId = winfo.wid();
+    if (existsFaultyWindow) {
+        cleanupFaultyWindows();
+    }
 
-            if (winfo.isMaximized() && !winfo.isMinimized()) {
-                foundActiveMaximized = true;
-                maxWinId = winfo.wid();
-            }
-        }
+    applyHints(layout);
+}
 
-        if (!foundActiveMaximized && winfo.isMaximized() && !winfo.isMinimized()) {
-            foundMaximized = true;
-            maxWinId = winfo.wid();
-        }
+void Windows::updateWindowHints(Latte::Layout::GenericLayout *layout, const WindowId &wid, const WindowInfoWrap &winfo)
+{
+    if (!m_layouts.contains(layout)) {
+        return;
+    }
 
-        //qDebug() << "window geometry ::: " << winfo.geometry();
+    bool tracked = isTrackedWindow(winfo);
+
+    m_layouts[layout]->setIsActiveWindow(wid, tracked && isActive(winfo));
+    m_layouts[layout]->setIsMaximizedWindow(wid, tracked && winfo.isMaximized());
+}
+
+void Windows::applyHints(Latte::Layout::GenericLayout *layout)
+{
+    if (!m_layouts.contains(layout) || !m_layouts[layout]->enabled() || !m_layouts[layout]->isTrackingCurrentActivity()) {
+        return;
     }
 
-    if (existsFaultyWindow) {
-        cleanupFaultyWindows();
+    bool foundActive{false};
+    bool foundActiveMaximized{false};
+
+    WindowId activeWinId;
+
+    for (const auto &wid : m_layouts[layout]->activeWindows()) {
+        foundActive = true;
+        activeWinId = wid;
+
+        if (m_windows.value(wid).isMaximized()) {
+            foundActiveMaximized = true;
+        }
     }
 
+    bool foundMaximized = !m_layouts[layout]->maximizedWindows().isEmpty();
+
     //! HACK: KWin Effects such as ShowDesktop have no way to be identified and as such
     //! create issues with identifying properly touching and maximized windows. BUT when
     //! they are enabled then NO ACTIVE window is found. This is a way to identify these
@@ -22,6 +22,7 @@
 
 // local
 #include <coretypes.h>
+#include "screenedgesindex.h"
 #include "../windowinfowrap.h"
 
 // Qt
@@ -120,7 +121,7 @@ signals:
     //! overloading WM signals in order to update first m_windows and afterwards
     //! inform consumers for window changes
     void activeWindowChanged(const WindowId &wid);
-    void windowChanged(const WindowId &wid);
+    void windowsChanged(const QList<WindowId> &wids);
     void windowRemoved(const WindowId &wid);
 
     void applicationDataChanged(const WindowId &wid);
@@ -141,11 +142,27 @@ private:
     void cleanupFaultyWindows();
 
     void updateAllHints();
-
-    //! Views
+    //! request windows information again and update hints only for them
+    void updateWindows(const QList<WindowId> &wids);
+    void updateWindowInfo(const WindowId &wid, QList<Latte::View *> &affectedViews);
+    //! incremental hints update for the windows that changed
+    void updateAffectedHints(const QList<WindowId> &windows, const QList<Latte::View *> &views);
+    void updateScreenEdgesIndex(Latte::View *view);
+
+    //! full rescan of all windows
     void updateHints(Latte::View *view);
     void updateHints(Latte::Layout::GenericLayout *layout);
 
+    //! update tracked windows lists for a single window
+    void updateWindowHints(Latte::View *view, const WindowId &wid, const WindowInfoWrap &winfo);
+    void updateWindowHints(Latte::Layout::GenericLayout *layout, const WindowId &wid, const WindowInfoWrap &winfo);
+
+    //! assign hints based on tracked windows lists
+    void applyHints(Latte::View *view);
+    void applyHints(Latte::Layout::GenericLayout *layout);
+
+    //! Views
+
     void setActiveWindowMaximized(Latte::View *view, bool activeMaximized);
     void setActiveWindowTouching(Latte::View *view, bool activeTouching);
     void setActiveWindowTouchingEdge(Latte::View *view, bool activeTouchingEdge);
@@ -164,6 +181,8 @@ private:
     void setActiveWindowScheme(Latte::Layout::GenericLayout *layout, WindowSystem::SchemeColors *scheme);
 
     //! Windows
+    bool isFaultyWindow(const WindowInfoWrap &winfo) const;
+    bool isTrackedWindow(const WindowInfoWrap &winfo);
     bool intersects(Latte::View *view, const WindowInfoWrap &winfo);
     bool isActive(const WindowInfoWrap &winfo);
     bool isActiveInViewScreen(Latte::View *view, const WindowInfoWrap &winfo);
@@ -196,6 +215,10 @@ private:
 
     QMap<WindowId, WindowInfoWrap> m_windows;
 
+    //! views per screen and edge, in order to re-evaluate only the views
+    //! that are affected from a window change
+    ScreenEdgesIndex m_screenEdgesIndex;
+
     //! Some applications delay their application name/icon identification
     //! such as Libreoffice that updates its StartupWMClass after
     //! its startup
@@ -29,6 +29,7 @@
 // Qt
 #include <QDebug>
 #include <QTimer>
+#include <QVector>
 #include <QtX11Extras/QX11Info>
 
 // KDE
@@ -42,6 +43,10 @@
 #include <xcb/xcb.h>
 #include <xcb/shape.h>
 
+//! window properties that are cached for each window
+#define WINDOWINFOPROPERTIES1 (NET::WMFrameExtents | NET::WMWindowType | NET::WMGeometry | NET::WMDesktop | NET::WMState | NET::WMName | NET::WMVisibleName)
+#define WINDOWINFOPROPERTIES2 (NET::WM2WindowClass | NET::WM2Activities | NET::WM2AllowedActions | NET::WM2TransientFor)
+
 namespace Latte {
 namespace WindowSystem {
 
@@ -51,7 +56,13 @@ XWindowInterface::XWindowInterface(QObject *parent)
     m_currentDesktop = QString(KWindowSystem::self()->currentDesktop());
 
     connect(KWindowSystem::self(), &KWindowSystem::activeWindowChanged, this, &AbstractWindowInterface::activeWindowChanged);
-    connect(KWindowSystem::self(), &KWindowSystem::windowRemoved, this, &AbstractWindowInterface::windowRemoved);
+    connect(KWindowSystem::self(), &KWindowSystem::windowRemoved, this, [&](WId wid) {
+        m_windowsInfo.remove(wid);
+#if KF5_VERSION_MINOR >= 65
+        m_gtkFrameExtents.remove(wid);
+#endif
+        emit windowRemoved(wid);
+    });
 
     connect(KWindowSystem::self(), &KWindowSystem::windowAdded, this, &XWindowInterface::windowAddedProxy);
 
@@ -66,7 +77,13 @@ XWindowInterface::XWindowInterface(QObject *parent)
             , this, &XWindowInterface::windowChangedProxy);
 
 
-    for(auto wid : KWindowSystem::self()->windows()) {
+    QList<WId> windows = KWindowSystem::self()->windows();
+
+#if KF5_VERSION_MINOR >= 65
+    fetchGtkFrameExtents(windows);
+#endif
+
+    for(auto wid : windows) {
         windowAddedProxy(wid);
     }
 }
@@ -329,11 +346,15 @@ void XWindowInterface::setActiveEdge(QWindow *view, bool active)
 }
 
 #if KF5_VERSION_MINOR >= 65
-QRect XWindowInterface::visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const
+QRect XWindowInterface::visibleGeometry(const WindowId &wid, const QRect &frameGeometry)
 {
-    NETWinInfo ni(QX11Info::connection(), wid.toUInt(), QX11Info::appRootWindow(), 0, NET::WM2GTKFrameExtents);
-    NETStrut struts = ni.gtkFrameExtents();
-    QMargins margins(struts.left, struts.top, struts.right, struts.bottom);
+    WId xid = wid.value<WId>();
+
+    if (!m_gtkFrameExtents.contains(xid)) {
+        fetchGtkFrameExtents({xid});
+    }
+
+    QMargins margins = m_gtkFrameExtents.value(xid);
     QRect visibleGeometry = frameGeometry;
 
     if (!margins.isNull()) {
@@ -342,8 +363,93 @@ QRect XWindowInterface::visibleGeometry(const WindowId &wid, const QRect &frameG
 
     return visibleGeometry;
 }
+
+void XWindowInterface::fetchGtkFrameExtents(const QList<WId> &windows)
+{
+    if (windows.isEmpty()) {
+        return;
+    }
+
+    xcb_atom_t atom = gtkFrameExtentsAtom();
+
+    if (atom == XCB_ATOM_NONE) {
+        return;
+    }
+
+    xcb_connection_t *c = QX11Info::connection();
+
+    //! send all requests first and afterwards collect their replies, that way
+    //! all windows are costing a single round-trip
+    QVector<xcb_get_property_cookie_t> cookies;
+    cookies.reserve(windows.count());
+
+    for (const auto wid : windows) {
+        cookies << xcb_get_property_unchecked(c, false, static_cast<xcb_window_t>(wid), atom, XCB_ATOM_CARDINAL, 0, 4);
+    }
+
+    for (int i=0; i<windows.count(); ++i) {
+        QScopedPointer<xcb_get_property_reply_t, QScopedPointerPodDeleter> reply(xcb_get_property_reply(c, cookies[i], nullptr));
+        QMargins margins;
+
+        if (reply && reply->type == XCB_ATOM_CARDINAL && reply->format == 32
+                && xcb_get_property_value_length(reply.data()) == 4 * sizeof(uint32_t)) {
+            //! _GTK_FRAME_EXTENTS order is left, right, top, bottom
+            const uint32_t *extents = static_cast<const uint32_t *>(xcb_get_property_value(reply.data()));
+            margins = QMargins(extents[0], extents[2], extents[1], extents[3]);
+        }
+
+        m_gtkFrameExtents[windows[i]] = margins;
+    }
+}
 #endif
 
+quint32 XWindowInterface::gtkFrameExtentsAtom()
+{
+    if (m_gtkFrameExtentsAtom == XCB_ATOM_NONE) {
+        xcb_connection_t *c = QX11Info::connection();
+        const QByteArray atomName = QByteArrayLiteral("_GTK_FRAME_EXTENTS");
+        xcb_intern_atom_cookie_t atomCookie = xcb_intern_atom_unchecked(c, false, atomName.length(), atomName.constData());
+        QScopedPointer<xcb_intern_atom_reply_t, QScopedPointerPodDeleter> atom(xcb_intern_atom_reply(c, atomCookie, nullptr));
+
+        if (atom) {
+            m_gtkFrameExtentsAtom = atom->atom;
+        }
+    }
+
+    return m_gtkFrameExtentsAtom;
+}
+
+KWindowInfo XWindowInterface::windowInfo(WId wid)
+{
+    auto cached = m_windowsInfo.constFind(wid);
+
+    if (cached != m_windowsInfo.constEnd()) {
+        return cached.value();
+    }
+
+    KWindowInfo info(wid, WINDOWINFOPROPERTIES1, WINDOWINFOPROPERTIES2);
+
+    //! windows that are not mapped yet should be requested again
+    if (info.valid()) {
+        m_windowsInfo.insert(wid, info);
+    }
+
+    return info;
+}
+
+void XWindowInterface::invalidateWindowInfo(WId wid, NET::Properties prop1, NET::Properties2 prop2)
+{
+    if ((prop1 & WINDOWINFOPROPERTIES1) || (prop2 & WINDOWINFOPROPERTIES2)) {
+        m_windowsInfo.remove(wid);
+    }
+
+#if KF5_VERSION_MINOR >= 65
+    //! moving or resizing a window does not change its frame extents
+    if (prop2 & NET::WM2GTKFrameExtents) {
+        m_gtkFrameExtents.remove(wid);
+    }
+#endif
+}
 
 void XWindowInterface::setFrameExtents(QWindow *view, const QMargins &margins)
 {
@@ -356,18 +462,15 @@ void XWindowInterface::setFrameExtents(QWindow *view, const QMargins &margins)
 
     if (margins.isNull()) {
         //! delete property
-        xcb_connection_t *c = QX11Info::connection();
-        const QByteArray atomName = QByteArrayLiteral("_GTK_FRAME_EXTENTS");
-        xcb_intern_atom_cookie_t atomCookie = xcb_intern_atom_unchecked(c, false, atomName.length(), atomName.constData());
-        QScopedPointer<xcb_intern_atom_reply_t, QScopedPointerPodDeleter> atom(xcb_intern_atom_reply(c, atomCookie, nullptr));
+        xcb_atom_t atom = gtkFrameExtentsAtom();
 
-        if (!atom) {
+        if (atom == XCB_ATOM_NONE) {
             return;
         }
 
         // qDebug() << "   deleting gtk frame extents atom..";
 
-        xcb_delete_property(c, view->winId(), atom->atom);
+        xcb_delete_property(QX11Info::connection(), view->winId(), atom);
     } else {
         NETStrut struts;
         struts.left = margins.left();
@@ -443,24 +546,14 @@ WindowInfoWrap XWindowInterface::requestInfoActive()
 
 WindowInfoWrap XWindowInterface::requestInfo(WindowId wid)
 {
-    const KWindowInfo winfo{wid.value<WId>(), NET::WMFrameExtents
-                | NET::WMWindowType
-                | NET::WMGeometry
-                | NET::WMDesktop
-                | NET::WMState
-                | NET::WMName
-                | NET::WMVisibleName,
-                NET::WM2WindowClass
-                | NET::WM2Activities
-                | NET::WM2AllowedActions
-                | NET::WM2TransientFor};
+    const KWindowInfo winfo = windowInfo(wid.value<WId>());
 
     WindowInfoWrap winfoWrap;
 
     const auto winClass = QString(winfo.windowClassName());
 
     //!used to track Plasma DesktopView windows because during startup can not be identified properly
-    bool plasmaBlockedWindow = (winClass == QLatin1String("plasmashell") && !isAcceptableWindow(wid));
+    bool plasmaBlockedWindow = (winClass == QLatin1String("plasmashell") && !isAcceptableWindow(wid, winfo));
 
     if (!winfo.valid() || plasmaBlockedWindow) {
         winfoWrap.setIsValid(false);
@@ -756,8 +849,11 @@ bool XWindowInterface::isValidWindow(WindowId wid)
 
 bool XWindowInterface::isAcceptableWindow(WindowId wid)
 {
-    const KWindowInfo info(wid.toUInt(), NET::WMGeometry | NET::WMState, NET::WM2WindowClass);
+    return isAcceptableWindow(wid, windowInfo(wid.toUInt()));
+}
 
+bool XWindowInterface::isAcceptableWindow(WindowId wid, const KWindowInfo &info)
+{
     const auto winClass = QString(info.windowClassName());
 
     //! ignored windows do not trackd
@@ -810,6 +906,8 @@ void XWindowInterface::windowAddedProxy(WId wid)
 
 void XWindowInterface::windowChangedProxy(WId wid, NET::Properties prop1, NET::Properties2 prop2)
 {
+    invalidateWindowInfo(wid, prop1, prop2);
+
     if (!isValidWindow(wid)) {
         return;
     }
@@ -27,6 +27,8 @@
 #include "windowinfowrap.h"
 
 // Qt
+#include <QHash>
+#include <QMargins>
 #include <QObject>
 
 // KDE
@@ -87,12 +89,23 @@ public:
 
 private:
     bool isAcceptableWindow(WindowId wid);
+    bool isAcceptableWindow(WindowId wid, const KWindowInfo &info);
     bool isValidWindow(WindowId wid);
 
+    //! cached window properties, they are fetched from X only when they are not
+    //! present or they were invalidated from a window changed signal
+    KWindowInfo windowInfo(WId wid);
+    void invalidateWindowInfo(WId wid, NET::Properties prop1, NET::Properties2 prop2);
+
 #if KF5_VERSION_MINOR >= 65
-    QRect visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const;
+    QRect visibleGeometry(const WindowId &wid, const QRect &frameGeometry);
+    //! request gtk frame extents for many windows with one round-trip
+    void fetchGtkFrameExtents(const QList<WId> &windows);
 #endif
 
+    //! _GTK_FRAME_EXTENTS atom, it is interned only once
+    quint32 gtkFrameExtentsAtom();
+
     void windowAddedProxy(WId wid);
     void windowChangedProxy(WId wid, NET::Properties prop1, NET::Properties2 prop2);
 
@@ -104,6 +117,13 @@ private:
     //xcb_shape
     bool m_shapeExtensionChecked{false};
     bool m_shapeAvailable{false};
+
+    quint32 m_gtkFrameExtentsAtom{0};
+
+    QHash<WId, KWindowInfo> m_windowsInfo;
+#if KF5_VERSION_MINOR >= 65
+    QHash<WId, QMargins> m_gtkFrameExtents;
+#endif
 };
 
 }
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "archivetools.h"
+
+// Qt
+#include <QtTest>
+#include <QTemporaryDir>
+
+// KDE
+#include <KArchive/KArchiveDirectory>
+#include <KArchive/KArchiveEntry>
+#include <KArchive/KArchiveFile>
+#include <KArchive/KTar>
+#include <KConfig>
+#include <KConfigGroup>
+
+//! a full backup with a few large layouts is usually a few megabytes
+#define BACKUPLAYOUTS 8
+#define BACKUPLAYOUTSIZE (512 * 1024)
+
+class ArchiveToolsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void configVersion_data();
+    void configVersion();
+    void archivedConfigVersion();
+
+    void benchmarkArchivedConfigVersion_data();
+    void benchmarkArchivedConfigVersion();
+
+private:
+    static QByteArray layoutContents(int size);
+    //! the previous implementation that extracted the config file in a temporary directory
+    static int extractedConfigVersion(const KArchiveDirectory *rootDir, const QString &fileName, const QString &groupName);
+
+private:
+    QTemporaryDir m_tempDir;
+    QString m_backupPath;
+};
+
+QByteArray ArchiveToolsTest::layoutContents(int size)
+{
+    QByteArray contents("[LayoutSettings]\nversion=2\n\n");
+
+    for (int i=0; contents.size()<size; ++i) {
+        contents += "[Containments][" + QByteArray::number(i) + "][General]\n";
+        contents += "iconSize=48\nzoomLevel=16\nthemeColors=0\nlaunchers=applications:org.kde.dolphin.desktop,applications:firefox.desktop\n\n";
+    }
+
+    return contents;
+}
+
+int ArchiveToolsTest::extractedConfigVersion(const KArchiveDirectory *rootDir, const QString &fileName, const QString &groupName)
+{
+    const KArchiveEntry *entry = rootDir->entry(fileName);
+
+    if (!entry || !entry->isFile()) {
+        return -1;
+    }
+
+    QTemporaryDir entryTempDir;
+
+    if (!static_cast<const KArchiveFile *>(entry)->copyTo(entryTempDir.path())) {
+        return -1;
+    }
+
+    KConfig config(entryTempDir.path() + "/" + fileName, KConfig::SimpleConfig);
+    KConfigGroup group = KConfigGroup(&config, groupName);
+
+    return group.readEntry("version", 1);
+}
+
+void ArchiveToolsTest::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+    m_backupPath = m_tempDir.path() + "/backup.latterc";
+
+    KTar archive(m_backupPath, QStringLiteral("application/x-tar"));
+    QVERIFY(archive.open(QIODevice::WriteOnly));
+
+    QVERIFY(archive.writeFile(QStringLiteral("lattedockrc"), "[General]\nversion=9\n\n[UniversalSettings]\nversion=2\ncurrentLayout=My Layout\n"));
+    QVERIFY(archive.writeFile(QStringLiteral("lattedock-appletsrc"), layoutContents(BACKUPLAYOUTSIZE)));
+
+    for (int i=0; i<BACKUPLAYOUTS; ++i) {
+        QVERIFY(archive.writeFile(QStringLiteral("latte/Layout %1.layout.latte").arg(i), layoutContents(BACKUPLAYOUTSIZE)));
+    }
+
+    QVERIFY(archive.close());
+}
+
+void ArchiveToolsTest::configVersion_data()
+{
+    QTest::addColumn<QByteArray>("contents");
+    QTest::addColumn<int>("version");
+
+    QTest::newRow("empty") << QByteArray() << 1;
+    QTest::newRow("missing-group") << QByteArray("[General]\nversion=2\n") << 1;
+    QTest::newRow("missing-entry") << QByteArray("[UniversalSettings]\nmemoryUsage=0\n") << 1;
+    QTest::newRow("simple") << QByteArray("[UniversalSettings]\nversion=2\n") << 2;
+    QTest::newRow("spaces") << QByteArray("  [UniversalSettings]  \n  version = 2  \n") << 2;
+    QTest::newRow("other-groups") << QByteArray("[General]\nversion=5\n[UniversalSettings]\nversion=2\n[Other]\nversion=7\n") << 2;
+    QTest::newRow("subgroup") << QByteArray("[UniversalSettings][Sub]\nversion=2\n") << 1;
+    QTest::newRow("similar-keys") << QByteArray("[UniversalSettings]\nversionName=5\nmyversion=4\n") << 1;
+    QTest::newRow("repeated-group") << QByteArray("[UniversalSettings]\nversion=1\n[General]\n[UniversalSettings]\nversion=2\n") << 2;
+    QTest::newRow("invalid-value") << QByteArray("[UniversalSettings]\nversion=two\n") << 1;
+    QTest::newRow("crlf") << QByteArray("[UniversalSettings]\r\nversion=2\r\n") << 2;
+}
+
+void ArchiveToolsTest::configVersion()
+{
+    QFETCH(QByteArray, contents);
+    QFETCH(int, version);
+
+    QCOMPARE(Latte::configVersion(contents, QStringLiteral("UniversalSettings")), version);
+}
+
+void ArchiveToolsTest::archivedConfigVersion()
+{
+    KTar archive(m_backupPath, QStringLiteral("application/x-tar"));
+    QVERIFY(archive.open(QIODevice::ReadOnly));
+
+    const KArchiveDirectory *rootDir = archive.directory();
+
+    QCOMPARE(Latte::archivedConfigVersion(rootDir, QStringLiteral("lattedockrc"), QStringLiteral("UniversalSettings")), 2);
+    QCOMPARE(Latte::archivedConfigVersion(rootDir, QStringLiteral("lattedock-appletsrc"), QStringLiteral("LayoutSettings")), 2);
+    QCOMPARE(Latte::archivedConfigVersion(rootDir, QStringLiteral("missingrc"), QStringLiteral("UniversalSettings")), -1);
+    QCOMPARE(Latte::archivedConfigVersion(rootDir, QStringLiteral("latte"), QStringLiteral("UniversalSettings")), -1);
+    QCOMPARE(Latte::archivedConfigVersion(nullptr, QStringLiteral("lattedockrc"), QStringLiteral("UniversalSettings")), -1);
+
+    //! identical answers with the KConfig parser
+    QCOMPARE(extractedConfigVersion(rootDir, QStringLiteral("lattedockrc"), QStringLiteral("UniversalSettings")), 2);
+    QCOMPARE(extractedConfigVersion(rootDir, QStringLiteral("lattedock-appletsrc"), QStringLiteral("LayoutSettings")), 2);
+}
+
+void ArchiveToolsTest::benchmarkArchivedConfigVersion_data()
+{
+    QTest::addColumn<bool>("extract");
+
+    QTest::newRow("memory") << false;
+    QTest::newRow("extract") << true;
+}
+
+void ArchiveToolsTest::benchmarkArchivedConfigVersion()
+{
+    QFETCH(bool, extract);
+
+    QVERIFY(QFileInfo(m_backupPath).size() > BACKUPLAYOUTS * BACKUPLAYOUTSIZE);
+
+    int rcVersion{-1};
+    int appletsVersion{-1};
+
+    //! the Importer::fileVersion() steps, the archive index is read and both config files are checked
+    QBENCHMARK {
+        KTar archive(m_backupPath, QStringLiteral("application/x-tar"));
+        archive.open(QIODevice::ReadOnly);
+
+        const KArchiveDirectory *rootDir = archive.directory();
+
+        if (extract) {
+            rcVersion = extractedConfigVersion(rootDir, QStringLiteral("lattedockrc"), QStringLiteral("UniversalSettings"));
+            appletsVersion = extractedConfigVersion(rootDir, QStringLiteral("lattedock-appletsrc"), QStringLiteral("LayoutSettings"));
+        } else {
+            rcVersion = Latte::archivedConfigVersion(rootDir, QStringLiteral("lattedockrc"), QStringLiteral("UniversalSettings"));
+            appletsVersion = Latte::archivedConfigVersion(rootDir, QStringLiteral("lattedock-appletsrc"), QStringLiteral("LayoutSettings"));
+        }
+    }
+
+    QCOMPARE(rcVersion, 2);
+    QCOMPARE(appletsVersion, 2);
+}
+
+QTEST_GUILESS_MAIN(ArchiveToolsTest)
+
+#include "archivetoolstest.moc"
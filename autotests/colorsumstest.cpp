@@ -0,0 +1,190 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "colorsums.h"
+
+// Qt
+#include <QtTest>
+#include <QVector>
+
+// C++
+#include <random>
+
+//! large enough for the products accumulators to exceed 32bit
+#define LARGEPIXELSCOUNT 40000
+
+Q_DECLARE_METATYPE(Latte::ColorSumsKernel)
+
+class ColorSumsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void kernels_data();
+    void kernels();
+    void reference();
+    void invalid();
+
+    void benchmarkColorSums_data();
+    void benchmarkColorSums();
+
+private:
+    static QVector<QRgb> randomPixels(int count);
+    static void compareSums(const Latte::ColorSums &sums, const Latte::ColorSums &expected);
+};
+
+QVector<QRgb> ColorSumsTest::randomPixels(int count)
+{
+    std::mt19937 generator(count);
+    QVector<QRgb> pixels(count);
+
+    for (int i=0; i<count; ++i) {
+        pixels[i] = generator();
+    }
+
+    return pixels;
+}
+
+void ColorSumsTest::compareSums(const Latte::ColorSums &sums, const Latte::ColorSums &expected)
+{
+    QCOMPARE(sums.red, expected.red);
+    QCOMPARE(sums.green, expected.green);
+    QCOMPARE(sums.blue, expected.blue);
+    QCOMPARE(sums.weight, expected.weight);
+}
+
+void ColorSumsTest::kernels_data()
+{
+    QTest::addColumn<Latte::ColorSumsKernel>("kernel");
+    QTest::addColumn<QVector<QRgb>>("pixels");
+
+    const QList<QPair<QByteArray, Latte::ColorSumsKernel>> kernels{
+        {"sse2", Latte::ColorSumsKernel::Sse2},
+        {"avx2", Latte::ColorSumsKernel::Avx2}};
+
+    //! sizes cover the empty input, the scalar tails and the vectorized bodies
+    const QList<int> sizes{0, 1, 3, 4, 7, 8, 9, 33, 1024, LARGEPIXELSCOUNT};
+
+    for (const auto &kernel : kernels) {
+        for (int size : sizes) {
+            QTest::newRow((kernel.first + "-random-" + QByteArray::number(size)).constData()) << kernel.second << randomPixels(size);
+        }
+
+        //! fully saturated and opaque pixels produce the largest weights
+        QTest::newRow((kernel.first + "-saturated").constData()) << kernel.second << QVector<QRgb>(LARGEPIXELSCOUNT, qRgba(255, 0, 0, 255));
+        QTest::newRow((kernel.first + "-white").constData()) << kernel.second << QVector<QRgb>(LARGEPIXELSCOUNT, qRgba(255, 255, 255, 255));
+        QTest::newRow((kernel.first + "-transparent").constData()) << kernel.second << QVector<QRgb>(LARGEPIXELSCOUNT, qRgba(0, 0, 0, 0));
+    }
+}
+
+void ColorSumsTest::kernels()
+{
+    QFETCH(Latte::ColorSumsKernel, kernel);
+    QFETCH(QVector<QRgb>, pixels);
+
+    if (!Latte::colorSumsKernelIsSupported(kernel)) {
+        QSKIP("kernel is not supported from this build or cpu");
+    }
+
+    Latte::ColorSums scalar;
+    Latte::colorSums(pixels.constData(), pixels.count(), scalar, Latte::ColorSumsKernel::Scalar);
+
+    Latte::ColorSums vectorized;
+    Latte::colorSums(pixels.constData(), pixels.count(), vectorized, kernel);
+    compareSums(vectorized, scalar);
+
+    Latte::ColorSums dispatched;
+    Latte::colorSums(pixels.constData(), pixels.count(), dispatched);
+    compareSums(dispatched, scalar);
+}
+
+void ColorSumsTest::reference()
+{
+    const QVector<QRgb> pixels = randomPixels(1024);
+
+    //! the float relevance that the integer weights are scaled from
+    double red{0};
+    double green{0};
+    double blue{0};
+    double weight{0};
+
+    for (const QRgb &pixel : pixels) {
+        const QColor color = QColor::fromRgba(pixel);
+        const double relevance = .1 + .9 * color.alphaF() * (qMax(color.redF(), qMax(color.greenF(), color.blueF())) - qMin(color.redF(), qMin(color.greenF(), color.blueF())));
+
+        red += color.red() * relevance;
+        green += color.green() * relevance;
+        blue += color.blue() * relevance;
+        weight += relevance;
+    }
+
+    Latte::ColorSums sums;
+    Latte::colorSums(pixels.constData(), pixels.count(), sums, Latte::ColorSumsKernel::Scalar);
+
+    //! the averages must be identical to the float ones
+    QVERIFY(qAbs(double(sums.red) / sums.weight - red / weight) < 0.0001);
+    QVERIFY(qAbs(double(sums.green) / sums.weight - green / weight) < 0.0001);
+    QVERIFY(qAbs(double(sums.blue) / sums.weight - blue / weight) < 0.0001);
+}
+
+void ColorSumsTest::invalid()
+{
+    const QRgb pixel = qRgba(255, 255, 255, 255);
+    Latte::ColorSums sums;
+
+    Latte::colorSums(nullptr, 10, sums);
+    Latte::colorSums(&pixel, 0, sums);
+    Latte::colorSums(&pixel, -1, sums);
+
+    compareSums(sums, Latte::ColorSums());
+}
+
+void ColorSumsTest::benchmarkColorSums_data()
+{
+    QTest::addColumn<Latte::ColorSumsKernel>("kernel");
+
+    QTest::newRow("scalar") << Latte::ColorSumsKernel::Scalar;
+    QTest::newRow("sse2") << Latte::ColorSumsKernel::Sse2;
+    QTest::newRow("avx2") << Latte::ColorSumsKernel::Avx2;
+}
+
+void ColorSumsTest::benchmarkColorSums()
+{
+    QFETCH(Latte::ColorSumsKernel, kernel);
+
+    if (!Latte::colorSumsKernelIsSupported(kernel)) {
+        QSKIP("kernel is not supported from this build or cpu");
+    }
+
+    //! a 256px icon, which is the usual large case for the dominant colors
+    const QVector<QRgb> pixels = randomPixels(256 * 256);
+    Latte::ColorSums sums;
+
+    QBENCHMARK {
+        Latte::colorSums(pixels.constData(), pixels.count(), sums, kernel);
+    }
+
+    QVERIFY(sums.weight > 0);
+}
+
+QTEST_GUILESS_MAIN(ColorSumsTest)
+
+#include "colorsumstest.moc"
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "commontools.h"
+
+// Qt
+#include <QtTest>
+#include <QVector>
+
+// C++
+#include <random>
+
+//! larger than the 32bit accumulators flush block of the vectorized kernels
+#define LARGEPIXELSCOUNT 40000
+
+Q_DECLARE_METATYPE(Latte::BrightnessKernel)
+
+class CommonToolsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void colorsBrightnessSumKernels_data();
+    void colorsBrightnessSumKernels();
+    void colorsBrightnessSumReference();
+    void colorsBrightnessSumInvalid();
+
+    void benchmarkColorsBrightnessSum_data();
+    void benchmarkColorsBrightnessSum();
+
+private:
+    static QVector<QRgb> randomPixels(int count);
+};
+
+QVector<QRgb> CommonToolsTest::randomPixels(int count)
+{
+    std::mt19937 generator(count);
+    QVector<QRgb> pixels(count);
+
+    for (int i=0; i<count; ++i) {
+        pixels[i] = generator();
+    }
+
+    return pixels;
+}
+
+void CommonToolsTest::colorsBrightnessSumKernels_data()
+{
+    QTest::addColumn<Latte::BrightnessKernel>("kernel");
+    QTest::addColumn<QVector<QRgb>>("pixels");
+
+    const QList<QPair<QByteArray, Latte::BrightnessKernel>> kernels{
+        {"sse2", Latte::BrightnessKernel::Sse2},
+        {"avx2", Latte::BrightnessKernel::Avx2}};
+
+    //! sizes cover the empty input, the scalar tails and the vectorized bodies
+    const QList<int> sizes{0, 1, 3, 4, 7, 8, 9, 33, 1024, LARGEPIXELSCOUNT};
+
+    for (const auto &kernel : kernels) {
+        for (int size : sizes) {
+            QTest::newRow((kernel.first + "-random-" + QByteArray::number(size)).constData()) << kernel.second << randomPixels(size);
+        }
+
+        QTest::newRow((kernel.first + "-white").constData()) << kernel.second << QVector<QRgb>(LARGEPIXELSCOUNT, qRgba(255, 255, 255, 255));
+        QTest::newRow((kernel.first + "-black").constData()) << kernel.second << QVector<QRgb>(LARGEPIXELSCOUNT, qRgba(0, 0, 0, 255));
+        QTest::newRow((kernel.first + "-transparent").constData()) << kernel.second << QVector<QRgb>(LARGEPIXELSCOUNT, qRgba(0, 0, 0, 0));
+    }
+}
+
+void CommonToolsTest::colorsBrightnessSumKernels()
+{
+    QFETCH(Latte::BrightnessKernel, kernel);
+    QFETCH(QVector<QRgb>, pixels);
+
+    if (!Latte::brightnessKernelIsSupported(kernel)) {
+        QSKIP("kernel is not supported from this build or cpu");
+    }
+
+    const quint64 scalar = Latte::colorsBrightnessSum(pixels.constData(), pixels.count(), Latte::BrightnessKernel::Scalar);
+
+    QCOMPARE(Latte::colorsBrightnessSum(pixels.constData(), pixels.count(), kernel), scalar);
+    QCOMPARE(Latte::colorsBrightnessSum(pixels.constData(), pixels.count()), scalar);
+}
+
+void CommonToolsTest::colorsBrightnessSumReference()
+{
+    const QVector<QRgb> pixels = randomPixels(1024);
+
+    quint64 reference{0};
+
+    for (const QRgb &pixel : pixels) {
+        reference += qRed(pixel) * 299 + qGreen(pixel) * 587 + qBlue(pixel) * 114;
+    }
+
+    QCOMPARE(Latte::colorsBrightnessSum(pixels.constData(), pixels.count(), Latte::BrightnessKernel::Scalar), reference);
+
+    //! the integer sum must agree with the float brightness that is used for single colors
+    const QRgb pixel = pixels[0];
+    QVERIFY(qAbs(Latte::colorBrightness(pixel) * 1000 - Latte::colorsBrightnessSum(&pixel, 1)) < 1);
+}
+
+void CommonToolsTest::colorsBrightnessSumInvalid()
+{
+    const QRgb pixel = qRgba(255, 255, 255, 255);
+
+    QCOMPARE(Latte::colorsBrightnessSum(nullptr, 10), quint64(0));
+    QCOMPARE(Latte::colorsBrightnessSum(&pixel, 0), quint64(0));
+    QCOMPARE(Latte::colorsBrightnessSum(&pixel, -1), quint64(0));
+}
+
+void CommonToolsTest::benchmarkColorsBrightnessSum_data()
+{
+    QTest::addColumn<Latte::BrightnessKernel>("kernel");
+
+    QTest::newRow("scalar") << Latte::BrightnessKernel::Scalar;
+    QTest::newRow("sse2") << Latte::BrightnessKernel::Sse2;
+    QTest::newRow("avx2") << Latte::BrightnessKernel::Avx2;
+}
+
+void CommonToolsTest::benchmarkColorsBrightnessSum()
+{
+    QFETCH(Latte::BrightnessKernel, kernel);
+
+    if (!Latte::brightnessKernelIsSupported(kernel)) {
+        QSKIP("kernel is not supported from this build or cpu");
+    }
+
+    //! a 256px icon, which is the usual large case for the background brightness
+    const QVector<QRgb> pixels = randomPixels(256 * 256);
+    quint64 sum{0};
+
+    QBENCHMARK {
+        sum += Latte::colorsBrightnessSum(pixels.constData(), pixels.count(), kernel);
+    }
+
+    QVERIFY(sum > 0);
+}
+
+QTEST_GUILESS_MAIN(CommonToolsTest)
+
+#include "commontoolstest.moc"
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+//! The fill applets algorithm as it was computed in LayouterPrivate.qml before
+//! FillAppletsSolver. It is used as reference and benchmark baseline for the native
+//! solver, so it receives the same batch and returns the same [max, min] pairs.
+//! AppletItem auto fill lengths are int properties, so assignments are truncated
+//! the same way QML does. The undefined "lendLayout" is replaced with the end layout.
+
+function solveFillApplets(layouts, justify, thickness, contentsMaxLength, minLength) {
+    var startLayout = layouts[0];
+    var mainLayout = layouts[1];
+    var endLayout = layouts[2];
+
+    function setAutoFillLength(applet, inMaxAutoFillCalculations, length) {
+        if (inMaxAutoFillCalculations) {
+            applet.maxAutoFillLength = length | 0;
+        } else {
+            applet.minAutoFillLength = length | 0;
+        }
+    }
+
+    function appletPreferredLength(min, pref, max){
+        if (max === -1) {
+            max = pref === -1 ? min : pref;
+        }
+
+        if (pref === -1) {
+            pref = max === -1 ? min : pref;
+        }
+
+        return  Math.min(Math.max(min,pref),max);
+    }
+
+    function initLayoutForFillsCalculations(layout) {
+        for(var i=0; i<layout.applets.length; ++i) {
+            layout.applets[i].inFillCalculations = true;
+        }
+    }
+
+    function computeStep1ForLayout(layout, availableSpace, sizePerApplet, noOfApplets, inMaxAutoFillCalculations) {
+        for(var i=0; i<layout.applets.length; ++i) {
+            var curApplet = layout.applets[i];
+
+            if (curApplet.hasMetrics) {
+                var minSize = curApplet.minimum;
+                var prefSize = curApplet.preferred;
+                var maxSize = curApplet.maximum;
+
+                minSize = minSize>=0 && minSize!==Infinity ? minSize : -1;
+                prefSize = minSize>=0 && prefSize!==Infinity ? prefSize : -1;
+                maxSize = maxSize>=0 && maxSize!== Infinity ? maxSize : -1;
+
+                var appliedSize = -1;
+                var systemDecide = ((minSize<0) && (prefSize<0) && (maxSize<0));
+
+                if (!systemDecide) {
+                    if (noOfApplets>1) {
+                        appliedSize = appletPreferredLength(minSize, prefSize, maxSize);
+                    } else if (noOfApplets===1) {
+                        appliedSize = appletPreferredLength(minSize, prefSize, Math.min(maxSize, sizePerApplet));
+                    }
+
+                    if (appliedSize>=0 && appliedSize<=sizePerApplet) {
+                        var properSize = Math.min(appliedSize, availableSpace);
+                        var adjustedSize = curApplet.isHidden ? 0 : Math.max(thickness, properSize);
+
+                        setAutoFillLength(curApplet, inMaxAutoFillCalculations, adjustedSize);
+
+                        curApplet.inFillCalculations = false;
+                        availableSpace = Math.max(0, availableSpace - curApplet.maxAutoFillLength);
+                        noOfApplets = noOfApplets - 1;
+                        sizePerApplet = noOfApplets > 1 ? Math.floor(availableSpace / noOfApplets) : availableSpace;
+                    }
+                }
+            }
+        }
+
+        return [availableSpace, sizePerApplet, noOfApplets];
+    }
+
+    function computeStep2ForLayout(layout, sizePerApplet, noOfApplets, inMaxAutoFillCalculations) {
+        if (sizePerApplet>=0) {
+            if (noOfApplets === 0) {
+                var mostDemandingAppletSize = 0;
+                var mostDemandingApplet = undefined;
+
+                var neutralAppletsNo = 0;
+                var neutralApplets = [];
+
+                for(var i=0; i<layout.applets.length; ++i) {
+                    var curApplet = layout.applets[i];
+
+                    if (curApplet.hasMetrics) {
+                        var isNeutral = (curApplet.minimum<=0 && curApplet.preferred<=0);
+
+                        if (!isNeutral && curApplet.maximum===Infinity
+                                && ((inMaxAutoFillCalculations && curApplet.maxAutoFillLength>mostDemandingAppletSize)
+                                    || (!inMaxAutoFillCalculations && curApplet.minAutoFillLength>mostDemandingAppletSize) )) {
+                            mostDemandingApplet = curApplet;
+                            mostDemandingAppletSize = inMaxAutoFillCalculations ? curApplet.maxAutoFillLength : curApplet.minAutoFillLength;
+                        } else if (isNeutral) {
+                            neutralAppletsNo = neutralAppletsNo + 1;
+                            neutralApplets.push(curApplet);
+                        }
+                    }
+                }
+
+                if (mostDemandingApplet) {
+                    var demandingLength = inMaxAutoFillCalculations ? mostDemandingApplet.maxAutoFillLength : mostDemandingApplet.minAutoFillLength;
+                    setAutoFillLength(mostDemandingApplet, inMaxAutoFillCalculations, demandingLength + sizePerApplet);
+                } else if (neutralAppletsNo>0) {
+                    var adjustedAppletSize = (sizePerApplet / neutralAppletsNo);
+                    for (var j=0; j<neutralApplets.length; ++j) {
+                        var neutralLength = inMaxAutoFillCalculations ? neutralApplets[j].maxAutoFillLength : neutralApplets[j].minAutoFillLength;
+                        setAutoFillLength(neutralApplets[j], inMaxAutoFillCalculations, neutralLength + adjustedAppletSize);
+                    }
+                }
+            } else {
+                for(var k=0; k<layout.applets.length; ++k) {
+                    var applet = layout.applets[k];
+
+                    if (applet.inFillCalculations) {
+                        setAutoFillLength(applet, inMaxAutoFillCalculations, sizePerApplet);
+                        applet.inFillCalculations = false;
+                    }
+                }
+            }
+        }
+    }
+
+    function initializationPhase(availableSpace, sizePerApplet, noOfApplets, inMaxAutoFillCalculations){
+        if (justify) {
+            initLayoutForFillsCalculations(startLayout);
+            initLayoutForFillsCalculations(endLayout);
+        }
+        initLayoutForFillsCalculations(mainLayout);
+
+        var res = computeStep1ForLayout(mainLayout, availableSpace, sizePerApplet, noOfApplets, inMaxAutoFillCalculations);
+        availableSpace = res[0]; sizePerApplet = res[1]; noOfApplets = res[2];
+
+        if (justify) {
+            res = computeStep1ForLayout(startLayout, availableSpace, sizePerApplet, noOfApplets, inMaxAutoFillCalculations);
+            availableSpace = res[0]; sizePerApplet = res[1]; noOfApplets = res[2];
+
+            res = computeStep1ForLayout(endLayout, availableSpace, sizePerApplet, noOfApplets, inMaxAutoFillCalculations);
+            availableSpace = res[0]; sizePerApplet = res[1]; noOfApplets = res[2];
+        }
+
+        return [availableSpace, sizePerApplet, noOfApplets];
+    }
+
+    function updateFillAppletsWithTwoSteps(inMaxAutoFillCalculations) {
+        var noA = startLayout.fillApplets + mainLayout.fillApplets + endLayout.fillApplets;
+        var max_length = inMaxAutoFillCalculations ? contentsMaxLength : minLength
+
+        var halfMainLayout = mainLayout.sizeWithNoFillApplets / 2;
+        var availableSpaceStart = Math.max(0, max_length/2 - startLayout.sizeWithNoFillApplets - halfMainLayout);
+        var availableSpaceEnd = Math.max(0, max_length/2 - endLayout.sizeWithNoFillApplets - halfMainLayout);
+        var availableSpace;
+
+        if (mainLayout.fillApplets === 0 || (startLayout.shownApplets ===0 && endLayout.shownApplets===0)){
+            availableSpace = availableSpaceStart + availableSpaceEnd - mainLayout.sizeWithNoFillApplets;
+        } else {
+            availableSpace = 2 * Math.min(availableSpaceStart, availableSpaceEnd) - mainLayout.sizeWithNoFillApplets;
+        }
+
+        var sizePerAppletMain = mainLayout.fillApplets > 0 ? availableSpace / noA : 0 ;
+
+        var noStart = startLayout.fillApplets;
+        var noMain = mainLayout.fillApplets;
+        var noEnd = endLayout.fillApplets;
+
+        initLayoutForFillsCalculations(startLayout);
+        initLayoutForFillsCalculations(mainLayout);
+        initLayoutForFillsCalculations(endLayout);
+
+        var res;
+
+        if (mainLayout.fillApplets > 0){
+            res = computeStep1ForLayout(mainLayout, availableSpace, sizePerAppletMain, noMain, inMaxAutoFillCalculations);
+            sizePerAppletMain = res[1]; noMain = res[2];
+            var dif = (availableSpace - res[0]) / 2;
+            availableSpaceStart = availableSpaceStart - dif;
+            availableSpaceEnd = availableSpaceEnd - dif;
+        }
+
+        var sizePerAppletStart = startLayout.fillApplets > 0 ? availableSpaceStart / noStart : 0 ;
+        var sizePerAppletEnd = endLayout.fillApplets > 0 ? availableSpaceEnd / noEnd : 0 ;
+
+        if (startLayout.fillApplets > 0) {
+            res = computeStep1ForLayout(startLayout, availableSpaceStart, sizePerAppletStart, noStart, inMaxAutoFillCalculations);
+            availableSpaceStart = res[0]; sizePerAppletStart = res[1]; noStart = res[2];
+        }
+        if (endLayout.fillApplets > 0) {
+            res = computeStep1ForLayout(endLayout, availableSpaceEnd, sizePerAppletEnd, noEnd, inMaxAutoFillCalculations);
+            availableSpaceEnd = res[0]; sizePerAppletEnd = res[1]; noEnd = res[2];
+        }
+
+        if (mainLayout.fillApplets > 0) {
+            computeStep2ForLayout(mainLayout, sizePerAppletMain, noMain, inMaxAutoFillCalculations);
+        }
+
+        if (startLayout.fillApplets > 0) {
+            if (mainLayout.fillApplets > 0) {
+                sizePerAppletStart = ((max_length/2) - (mainLayout.length/2) - startLayout.sizeWithNoFillApplets) / noStart;
+            }
+
+            computeStep2ForLayout(startLayout, sizePerAppletStart, noStart, inMaxAutoFillCalculations);
+        }
+
+        if (endLayout.fillApplets > 0) {
+            if (mainLayout.fillApplets > 0) {
+                sizePerAppletEnd = ((max_length/2) - (mainLayout.length/2) - endLayout.sizeWithNoFillApplets) / noEnd;
+            }
+
+            computeStep2ForLayout(endLayout, sizePerAppletEnd, noEnd, inMaxAutoFillCalculations);
+        }
+    }
+
+    function updateFillAppletsWithOneStep(inMaxAutoFillCalculations) {
+        var max_length = inMaxAutoFillCalculations ? contentsMaxLength : minLength
+        var noA = startLayout.fillApplets + mainLayout.fillApplets + endLayout.fillApplets;
+
+        var availableSpace = Math.max(0, max_length - startLayout.sizeWithNoFillApplets - mainLayout.sizeWithNoFillApplets - endLayout.sizeWithNoFillApplets);
+        var sizePerApplet = availableSpace / noA;
+
+        var res = initializationPhase(availableSpace, sizePerApplet, noA, inMaxAutoFillCalculations);
+        availableSpace = res[0];  sizePerApplet = res[1]; noA = res[2];
+
+        var remainedSpace = (noA === 0 && sizePerApplet > 0) ? true : false
+
+        var startNo = -1;
+        var mainNo = -1;
+        var endNo = -1;
+
+        if (remainedSpace) {
+            if (startLayout.fillApplets > 0) {
+                startNo = 0;
+            } else if (endLayout.fillApplets > 0) {
+                endNo = 0;
+            } else if (mainLayout.fillApplets > 0) {
+                mainNo = 0;
+            }
+        }
+
+        computeStep2ForLayout(startLayout, sizePerApplet, startNo, inMaxAutoFillCalculations);
+        computeStep2ForLayout(mainLayout, sizePerApplet, mainNo, inMaxAutoFillCalculations);
+        computeStep2ForLayout(endLayout, sizePerApplet, endNo, inMaxAutoFillCalculations);
+    }
+
+    var noA = startLayout.fillApplets + mainLayout.fillApplets + endLayout.fillApplets;
+
+    if (noA > 0) {
+        var use_maximum_length = true;
+
+        if (mainLayout.shownApplets === 0 || !justify) {
+            updateFillAppletsWithOneStep(use_maximum_length);
+            updateFillAppletsWithOneStep(!use_maximum_length);
+        } else {
+            updateFillAppletsWithTwoSteps(use_maximum_length);
+            updateFillAppletsWithTwoSteps(!use_maximum_length);
+        }
+    }
+
+    var result = [];
+
+    for (var l=0; l<layouts.length; ++l) {
+        var lengths = [];
+
+        for (var a=0; a<layouts[l].applets.length; ++a) {
+            lengths.push(layouts[l].applets[a].maxAutoFillLength);
+            lengths.push(layouts[l].applets[a].minAutoFillLength);
+        }
+
+        result.push(lengths);
+    }
+
+    return result;
+}
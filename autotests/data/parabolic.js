@@ -0,0 +1,131 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+//! The parabolic effect of the tasks as it was computed before ParabolicEngine. Every
+//! sglUpdateLowerItemScale/sglUpdateHigherItemScale signal was received by all tasks
+//! wrappers and each one of them was running its sltUpdate*ItemScale slot. It is used
+//! as reference and benchmark baseline for the native engine. "accepted" is false for
+//! separators and hidden tasks, the hovered task is never updated through the chain
+//! because it contains the mouse.
+
+function createParabolicChain(accepted) {
+    var chain = {
+        scales: [],
+        hoveredIndex: -1
+    };
+
+    for (var i=0; i<accepted.length; ++i) {
+        chain.scales.push(1);
+    }
+
+    function updateScale(index, nIndex, nScale, step) {
+        if (index === chain.hoveredIndex || index !== nIndex) {
+            return;
+        }
+
+        if (nScale >= 0) {
+            chain.scales[index] = nScale + step;
+        } else {
+            chain.scales[index] = chain.scales[index] + step;
+        }
+    }
+
+    function sglUpdateLowerItemScale(delegateIndex, newScale, step) {
+        for (var index=0; index<accepted.length; ++index) {
+            if (delegateIndex === index) {
+                if (accepted[index]) {
+                    updateScale(index, delegateIndex, newScale, step);
+
+                    if (newScale > 1) {
+                        sglUpdateLowerItemScale(delegateIndex-1, 1, 0);
+                    }
+                } else {
+                    sglUpdateLowerItemScale(delegateIndex-1, newScale, step);
+                }
+            } else if ((newScale === 1) && (index < delegateIndex)) {
+                updateScale(index, index, 1, 0);
+            }
+        }
+    }
+
+    function sglUpdateHigherItemScale(delegateIndex, newScale, step) {
+        for (var index=0; index<accepted.length; ++index) {
+            if (delegateIndex === index) {
+                if (accepted[index]) {
+                    updateScale(index, delegateIndex, newScale, step);
+
+                    if (newScale > 1) {
+                        sglUpdateHigherItemScale(delegateIndex+1, 1, 0);
+                    }
+                } else {
+                    sglUpdateHigherItemScale(delegateIndex+1, newScale, step);
+                }
+            } else if ((newScale === 1) && (index > delegateIndex)) {
+                updateScale(index, index, 1, 0);
+            }
+        }
+    }
+
+    chain.applyParabolicEffect = function(index, currentMousePosition, center, zoom, reversed) {
+        chain.hoveredIndex = index;
+
+        var rDistance = Math.abs(currentMousePosition  - center);
+
+        //check if the mouse goes right or down according to the center
+        var positiveDirection =  ((currentMousePosition  - center) >= 0 );
+
+        if (reversed) {
+            positiveDirection = !positiveDirection;
+        }
+
+        //finding the zoom center e.g. for zoom:1.7, calculates 0.35
+        var zoomCenter = (zoom - 1) / 2
+
+        //computes the in the scale e.g. 0...0.35 according to the mouse distance
+        //0.35 on the edge and 0 in the center
+        var firstComputation = (rDistance / center) * zoomCenter;
+
+        //calculates the scaling for the neighbour tasks
+        var bigNeighbourZoom = Math.min(1 + zoomCenter + firstComputation, zoom);
+        var smallNeighbourZoom = Math.max(1 + zoomCenter - firstComputation, 1);
+
+        var leftScale;
+        var rightScale;
+
+        if(positiveDirection === true){
+            rightScale = bigNeighbourZoom;
+            leftScale = smallNeighbourZoom;
+        }
+        else {
+            rightScale = smallNeighbourZoom;
+            leftScale = bigNeighbourZoom;
+        }
+
+        //! the hovered task zooms by itself in calculateParabolicScales()
+        chain.scales[index] = zoom;
+
+        sglUpdateHigherItemScale(index+1 , rightScale, 0);
+        sglUpdateLowerItemScale(index-1, leftScale, 0);
+
+        return {leftScale:leftScale, rightScale:rightScale};
+    };
+
+    return chain;
+}
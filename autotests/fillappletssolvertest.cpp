@@ -0,0 +1,282 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "fillappletssolver.h"
+
+// Qt
+#include <QtTest>
+#include <QFile>
+#include <QJSEngine>
+#include <QJSValue>
+
+// C++
+#include <limits>
+
+#define INF std::numeric_limits<qreal>::infinity()
+
+typedef QList<QList<int>> Lengths;
+
+class FillAppletsSolverTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void oneStep();
+    void twoSteps();
+    void remainingSpaceToEndLayout();
+
+    void compareWithJavascript_data();
+    void compareWithJavascript();
+
+    void benchmarkSolve_data();
+    void benchmarkSolve();
+
+private:
+    static QVariantMap applet(qreal minimum, qreal preferred, qreal maximum, bool isHidden = false);
+    static QVariantMap layout(int fillApplets, int shownApplets, qreal sizeWithNoFillApplets, qreal length, const QVariantList &applets);
+    //! start, main and end layouts with applets that exercise all algorithm branches
+    static QVariantList panelLayouts(int fillAppletsPerLayout);
+
+    static Lengths toLengths(const QVariantList &layouts);
+
+    Lengths solveNative(const QVariantList &layouts, bool justify, int thickness, int maxLength, int minLength) const;
+    Lengths solveJavascript(const QVariantList &layouts, bool justify, int thickness, int maxLength, int minLength);
+
+private:
+    QJSEngine m_engine;
+    QJSValue m_jsSolve;
+};
+
+QVariantMap FillAppletsSolverTest::applet(qreal minimum, qreal preferred, qreal maximum, bool isHidden)
+{
+    QVariantMap data;
+    data[QStringLiteral("hasMetrics")] = true;
+    data[QStringLiteral("isHidden")] = isHidden;
+    data[QStringLiteral("minimum")] = minimum;
+    data[QStringLiteral("preferred")] = preferred;
+    data[QStringLiteral("maximum")] = maximum;
+    data[QStringLiteral("maxAutoFillLength")] = -1;
+    data[QStringLiteral("minAutoFillLength")] = -1;
+
+    return data;
+}
+
+QVariantMap FillAppletsSolverTest::layout(int fillApplets, int shownApplets, qreal sizeWithNoFillApplets, qreal length, const QVariantList &applets)
+{
+    QVariantMap data;
+    data[QStringLiteral("fillApplets")] = fillApplets;
+    data[QStringLiteral("shownApplets")] = shownApplets;
+    data[QStringLiteral("sizeWithNoFillApplets")] = sizeWithNoFillApplets;
+    data[QStringLiteral("length")] = length;
+    data[QStringLiteral("applets")] = applets;
+
+    return data;
+}
+
+QVariantList FillAppletsSolverTest::panelLayouts(int fillAppletsPerLayout)
+{
+    QVariantList layouts;
+
+    for (int l=0; l<3; ++l) {
+        QVariantList applets;
+
+        for (int i=0; i<fillAppletsPerLayout; ++i) {
+            switch ((i + l) % 4) {
+            case 0:
+                applets << applet(-1, -1, -1);
+                break;
+            case 1:
+                applets << applet(48, 96, 128);
+                break;
+            case 2:
+                applets << applet(64, 64, INF);
+                break;
+            default:
+                applets << applet(0, 0, INF, (i % 8) == 3);
+                break;
+            }
+        }
+
+        layouts << layout(fillAppletsPerLayout, 2 * fillAppletsPerLayout, 60 * fillAppletsPerLayout, 100 * fillAppletsPerLayout, applets);
+    }
+
+    return layouts;
+}
+
+Lengths FillAppletsSolverTest::toLengths(const QVariantList &layouts)
+{
+    Lengths result;
+
+    for (const auto &layoutLengths : layouts) {
+        QList<int> lengths;
+
+        for (const auto &length : layoutLengths.toList()) {
+            lengths << qRound(length.toDouble());
+        }
+
+        result << lengths;
+    }
+
+    return result;
+}
+
+Lengths FillAppletsSolverTest::solveNative(const QVariantList &layouts, bool justify, int thickness, int maxLength, int minLength) const
+{
+    Latte::FillAppletsSolver solver;
+    solver.setJustify(justify);
+    solver.setThickness(thickness);
+    solver.setMaxLength(maxLength);
+    solver.setMinLength(minLength);
+
+    return toLengths(solver.solve(layouts));
+}
+
+Lengths FillAppletsSolverTest::solveJavascript(const QVariantList &layouts, bool justify, int thickness, int maxLength, int minLength)
+{
+    const QJSValue result = m_jsSolve.call({m_engine.toScriptValue(layouts), justify, thickness, maxLength, minLength});
+
+    return toLengths(result.toVariant().toList());
+}
+
+void FillAppletsSolverTest::initTestCase()
+{
+    QFile script(QFINDTESTDATA("data/fillappletssolver.js"));
+    QVERIFY(script.open(QIODevice::ReadOnly));
+
+    const QJSValue evaluation = m_engine.evaluate(QString::fromUtf8(script.readAll()), script.fileName());
+    QVERIFY2(!evaluation.isError(), qPrintable(evaluation.toString()));
+
+    m_jsSolve = m_engine.globalObject().property(QStringLiteral("solveFillApplets"));
+    QVERIFY(m_jsSolve.isCallable());
+}
+
+//! not justified alignment, the applet with metrics is resolved in step1 and the
+//! system decided applet receives the remaining space in step2
+void FillAppletsSolverTest::oneStep()
+{
+    const QVariantList layouts{
+        layout(0, 0, 0, 0, {}),
+        layout(2, 4, 200, 0, {applet(100, 150, 200), applet(-1, -1, -1)}),
+        layout(0, 0, 0, 0, {})};
+
+    const Lengths expected{{}, {150, 150, 650, 150}, {}};
+
+    QCOMPARE(solveNative(layouts, false, 40, 1000, 500), expected);
+}
+
+//! justify alignment with fill applets in all layouts, the main layout is resolved
+//! first and the start/end fill applets share the space around it
+void FillAppletsSolverTest::twoSteps()
+{
+    const QVariantList layouts{
+        layout(1, 2, 100, 0, {applet(-1, -1, -1)}),
+        layout(1, 2, 100, 300, {applet(200, 200, 200)}),
+        layout(1, 1, 0, 0, {applet(-1, -1, -1)})};
+
+    const Lengths expected{{250, 50}, {200, 66}, {350, 150}};
+
+    QCOMPARE(solveNative(layouts, true, 40, 1000, 600), expected);
+}
+
+//! justify alignment with an empty main layout and no start fill applets, the space
+//! that remains after step1 is given to the most demanding end applet. The qml
+//! version was failing at this point because of the undefined "lendLayout"
+void FillAppletsSolverTest::remainingSpaceToEndLayout()
+{
+    const QVariantList layouts{
+        layout(0, 0, 0, 0, {}),
+        layout(0, 0, 0, 0, {}),
+        layout(1, 2, 100, 0, {applet(100, 100, INF)})};
+
+    const Lengths expected{{}, {}, {900, 100}};
+
+    QCOMPARE(solveNative(layouts, true, 40, 1000, 500), expected);
+}
+
+void FillAppletsSolverTest::compareWithJavascript_data()
+{
+    QTest::addColumn<QVariantList>("layouts");
+    QTest::addColumn<bool>("justify");
+    QTest::addColumn<int>("maxLength");
+    QTest::addColumn<int>("minLength");
+
+    for (int applets : {1, 2, 3, 5, 8}) {
+        const QByteArray count = QByteArray::number(applets);
+        QTest::newRow(("justify-" + count).constData()) << panelLayouts(applets) << true << 1600 << 800;
+        QTest::newRow(("justify-tight-" + count).constData()) << panelLayouts(applets) << true << 300 << 100;
+        QTest::newRow(("centered-" + count).constData()) << panelLayouts(applets) << false << 1600 << 800;
+    }
+}
+
+void FillAppletsSolverTest::compareWithJavascript()
+{
+    QFETCH(QVariantList, layouts);
+    QFETCH(bool, justify);
+    QFETCH(int, maxLength);
+    QFETCH(int, minLength);
+
+    QCOMPARE(solveNative(layouts, justify, 48, maxLength, minLength), solveJavascript(layouts, justify, 48, maxLength, minLength));
+}
+
+void FillAppletsSolverTest::benchmarkSolve_data()
+{
+    QTest::addColumn<bool>("javascript");
+    QTest::addColumn<int>("applets");
+
+    for (int applets : {2, 8, 32}) {
+        const QByteArray count = QByteArray::number(applets);
+        QTest::newRow(("native-" + count).constData()) << false << applets;
+        QTest::newRow(("javascript-" + count).constData()) << true << applets;
+    }
+}
+
+void FillAppletsSolverTest::benchmarkSolve()
+{
+    QFETCH(bool, javascript);
+    QFETCH(int, applets);
+
+    const QVariantList layouts = panelLayouts(applets);
+
+    if (javascript) {
+        //! the qml version was reading the applets directly, so the conversion is not measured
+        const QJSValue jsLayouts = m_engine.toScriptValue(layouts);
+
+        QBENCHMARK {
+            m_jsSolve.call({jsLayouts, true, 48, 1600, 800});
+        }
+    } else {
+        Latte::FillAppletsSolver solver;
+        solver.setJustify(true);
+        solver.setThickness(48);
+        solver.setMaxLength(1600);
+        solver.setMinLength(800);
+
+        QBENCHMARK {
+            solver.solve(layouts);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(FillAppletsSolverTest)
+
+#include "fillappletssolvertest.moc"
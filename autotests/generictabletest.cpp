@@ -0,0 +1,258 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "appletdata.h"
+
+// Qt
+#include <QtTest>
+
+class GenericTableTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void indexAfterInsertAndRemove();
+    void indexAfterReferenceChanges();
+    void duplicateIdsThroughReferences();
+    void sortedInsertAfterRename();
+
+    void benchmarkContainsId_data();
+    void benchmarkContainsId();
+    void benchmarkIndexOf_data();
+    void benchmarkIndexOf();
+    void benchmarkInsertBasedOnName_data();
+    void benchmarkInsertBasedOnName();
+
+private:
+    static Latte::Data::Applet applet(const QString &id, const QString &name);
+    //! applets with ids and names sorted in the same order
+    static Latte::Data::AppletsTable appletsTable(int count);
+    static void benchmarkSizes();
+
+    //! the table answers must be identical to a plain search of its rows
+    static int linearIndexOf(const Latte::Data::AppletsTable &table, const QString &id);
+    static void verifyIndex(const Latte::Data::AppletsTable &table, const QStringList &ids);
+};
+
+Latte::Data::Applet GenericTableTest::applet(const QString &id, const QString &name)
+{
+    Latte::Data::Applet record;
+    record.id = id;
+    record.name = name;
+
+    return record;
+}
+
+Latte::Data::AppletsTable GenericTableTest::appletsTable(int count)
+{
+    Latte::Data::AppletsTable table;
+
+    for (int i=0; i<count; ++i) {
+        const QString number = QString::number(i).rightJustified(6, '0');
+        table << applet(QStringLiteral("org.kde.applet.") + number, QStringLiteral("Applet ") + number);
+    }
+
+    return table;
+}
+
+void GenericTableTest::benchmarkSizes()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("5000") << 5000;
+}
+
+int GenericTableTest::linearIndexOf(const Latte::Data::AppletsTable &table, const QString &id)
+{
+    for (int i=0; i<table.rowCount(); ++i) {
+        if (table[(uint)i].id == id) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void GenericTableTest::verifyIndex(const Latte::Data::AppletsTable &table, const QStringList &ids)
+{
+    for (const auto &id : ids) {
+        QCOMPARE(table.indexOf(id), linearIndexOf(table, id));
+        QCOMPARE(table.containsId(id), linearIndexOf(table, id) >= 0);
+    }
+}
+
+void GenericTableTest::indexAfterInsertAndRemove()
+{
+    Latte::Data::AppletsTable table = appletsTable(10);
+    const QStringList ids{"org.kde.applet.000000", "org.kde.applet.000005", "org.kde.applet.000009", "first", "middle", "last", "missing"};
+
+    table.insert(0, applet("first", "First"));
+    table.insert(6, applet("middle", "Middle"));
+    table << applet("last", "Last");
+    verifyIndex(table, ids);
+
+    table.remove(QStringLiteral("middle"));
+    table.remove(0);
+    table.remove(table.rowCount() - 1);
+    verifyIndex(table, ids);
+
+    //! duplicate ids always resolve to their first row
+    table.insert(3, applet("org.kde.applet.000009", "Duplicate"));
+    verifyIndex(table, ids);
+    table.remove(3);
+    verifyIndex(table, ids);
+}
+
+void GenericTableTest::indexAfterReferenceChanges()
+{
+    Latte::Data::AppletsTable table = appletsTable(10);
+    const QStringList ids{"org.kde.applet.000002", "org.kde.applet.000004", "renamed", "renamedbyid"};
+
+    table[2].id = QStringLiteral("renamed");
+    verifyIndex(table, ids);
+
+    table[QStringLiteral("org.kde.applet.000004")].id = QStringLiteral("renamedbyid");
+    verifyIndex(table, ids);
+
+    //! rows are inserted and removed after records were changed through references
+    table[5].id = QStringLiteral("org.kde.applet.000002");
+    table.insert(0, applet("renamed", "Renamed"));
+    verifyIndex(table, ids);
+
+    table[1].name = QStringLiteral("Only name changed");
+    table.remove(0);
+    verifyIndex(table, ids);
+}
+
+void GenericTableTest::duplicateIdsThroughReferences()
+{
+    Latte::Data::AppletsTable table;
+    table << applet("x", "X") << applet("a", "A") << applet("b", "B");
+
+    QCOMPARE(table.indexOf("a"), 1);
+
+    //! an earlier row gains the id of a later one while the index is still dirty
+    table[0].id = QStringLiteral("a");
+    QCOMPARE(table.indexOf("a"), 0);
+    QVERIFY(!table.containsId("x"));
+
+    table[QStringLiteral("b")].id = QStringLiteral("a");
+    QCOMPARE(table.indexOf("a"), 0);
+
+    table.remove(0);
+    QCOMPARE(table.indexOf("a"), 0);
+    table.remove(0);
+    QCOMPARE(table.indexOf("a"), 0);
+    QCOMPARE(table.rowCount(), 1);
+}
+
+void GenericTableTest::sortedInsertAfterRename()
+{
+    Latte::Data::AppletsTable table = appletsTable(10);
+
+    table[0].name = QStringLiteral("Z applet");
+    table.insertBasedOnName(applet("new", "Applet 000003b"));
+
+    int expectedPos{0};
+
+    for (int i=0; i<table.rowCount(); ++i) {
+        if (table[(uint)i].id == QLatin1String("new")) {
+            expectedPos = i;
+        }
+    }
+
+    //! the table is not sorted anymore, so the first row with a bigger name is used
+    QCOMPARE(expectedPos, 0);
+    verifyIndex(table, {"new", "org.kde.applet.000000", "org.kde.applet.000003"});
+}
+
+void GenericTableTest::benchmarkContainsId_data()
+{
+    benchmarkSizes();
+}
+
+void GenericTableTest::benchmarkContainsId()
+{
+    QFETCH(int, count);
+
+    const Latte::Data::AppletsTable table = appletsTable(count);
+    const QString lastId = table[(uint)(count - 1)].id;
+    bool found{false};
+
+    QBENCHMARK {
+        found = table.containsId(lastId) && !table.containsId(QStringLiteral("missing"));
+    }
+
+    QVERIFY(found);
+}
+
+void GenericTableTest::benchmarkIndexOf_data()
+{
+    benchmarkSizes();
+}
+
+void GenericTableTest::benchmarkIndexOf()
+{
+    QFETCH(int, count);
+
+    Latte::Data::AppletsTable table = appletsTable(count);
+    const QString middleId = table[(uint)(count / 2)].id;
+    int pos{-1};
+
+    //! the usual settings pattern, a record is updated through a reference and it is searched again
+    QBENCHMARK {
+        table[(uint)(count / 3)].description = QStringLiteral("updated");
+        pos = table.indexOf(middleId);
+    }
+
+    QCOMPARE(pos, count / 2);
+}
+
+void GenericTableTest::benchmarkInsertBasedOnName_data()
+{
+    benchmarkSizes();
+}
+
+void GenericTableTest::benchmarkInsertBasedOnName()
+{
+    QFETCH(int, count);
+
+    const Latte::Data::AppletsTable source = appletsTable(count);
+    Latte::Data::AppletsTable table;
+
+    QBENCHMARK {
+        table.clear();
+
+        //! records are inserted in reverse order so every insertion searches its sorted position
+        for (int i=count-1; i>=0; --i) {
+            table.insertBasedOnName(source[(uint)i]);
+        }
+    }
+
+    QCOMPARE(table.rowCount(), count);
+    QCOMPARE(table.indexOf(source[0].id), 0);
+}
+
+QTEST_GUILESS_MAIN(GenericTableTest)
+
+#include "generictabletest.moc"
@@ -0,0 +1,455 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "parabolicengine.h"
+
+// Qt
+#include <QtTest>
+#include <QFile>
+#include <QJSEngine>
+#include <QJSValue>
+
+// C++
+#include <memory>
+#include <random>
+#include <vector>
+
+#define ZOOM 1.6
+#define CENTER 24.0
+
+//! the qml wrappers expose the same property to the engine
+class ParabolicItem : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal parabolicScale READ parabolicScale WRITE setParabolicScale NOTIFY parabolicScaleChanged)
+
+public:
+    qreal parabolicScale() const
+    {
+        return m_parabolicScale;
+    }
+
+    void setParabolicScale(qreal scale)
+    {
+        if (m_parabolicScale == scale) {
+            return;
+        }
+
+        m_parabolicScale = scale;
+        ++changes;
+        emit parabolicScaleChanged();
+    }
+
+    int changes{0};
+
+signals:
+    void parabolicScaleChanged();
+
+private:
+    qreal m_parabolicScale{1.0};
+};
+
+typedef std::vector<std::unique_ptr<ParabolicItem>> ParabolicItems;
+
+class ParabolicEngineTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void hoveredNeighbours();
+    void skippedItems();
+    void reversedDirection();
+    void layoutsAreNotCrossed();
+    void clientEngine();
+    void onlyChangedScalesAreNotified();
+    void movedAndDestroyedItems();
+
+    void compareWithJavascript_data();
+    void compareWithJavascript();
+
+    void benchmarkParabolicEffect_data();
+    void benchmarkParabolicEffect();
+
+private:
+    //! every seventh task is a separator or hidden
+    static QList<bool> tasksAccepted(int count);
+    static ParabolicItems registerItems(Latte::ParabolicEngine &engine, const QList<bool> &accepted, int firstIndex = 0);
+
+    static int changes(const ParabolicItems &items);
+    static void compareScales(const Latte::ParabolicEngine &engine, const ParabolicItems &items, const QList<qreal> &expected, int firstIndex = 0);
+
+private:
+    QJSEngine m_engine;
+    QJSValue m_jsCreateChain;
+};
+
+QList<bool> ParabolicEngineTest::tasksAccepted(int count)
+{
+    QList<bool> accepted;
+
+    for (int i=0; i<count; ++i) {
+        accepted << ((i % 7) != 3);
+    }
+
+    return accepted;
+}
+
+ParabolicItems ParabolicEngineTest::registerItems(Latte::ParabolicEngine &engine, const QList<bool> &accepted, int firstIndex)
+{
+    ParabolicItems items;
+
+    for (int i=0; i<accepted.count(); ++i) {
+        items.emplace_back(new ParabolicItem);
+        engine.setItem(firstIndex + i, items.back().get(), accepted[i]);
+    }
+
+    return items;
+}
+
+int ParabolicEngineTest::changes(const ParabolicItems &items)
+{
+    int changes{0};
+
+    for (const auto &item : items) {
+        changes += item->changes;
+    }
+
+    return changes;
+}
+
+void ParabolicEngineTest::compareScales(const Latte::ParabolicEngine &engine, const ParabolicItems &items, const QList<qreal> &expected, int firstIndex)
+{
+    QCOMPARE((int)items.size(), expected.count());
+
+    for (int i=0; i<expected.count(); ++i) {
+        QVERIFY2(qFuzzyCompare(engine.scale(firstIndex + i), expected[i]), qPrintable(QString("index %1: %2 != %3").arg(firstIndex + i).arg(engine.scale(firstIndex + i)).arg(expected[i])));
+        QVERIFY(qFuzzyCompare(items[i]->parabolicScale(), expected[i]));
+    }
+}
+
+void ParabolicEngineTest::initTestCase()
+{
+    QFile script(QFINDTESTDATA("data/parabolic.js"));
+    QVERIFY(script.open(QIODevice::ReadOnly));
+
+    const QJSValue evaluation = m_engine.evaluate(QString::fromUtf8(script.readAll()), script.fileName());
+    QVERIFY2(!evaluation.isError(), qPrintable(evaluation.toString()));
+
+    m_jsCreateChain = m_engine.globalObject().property(QStringLiteral("createParabolicChain"));
+    QVERIFY(m_jsCreateChain.isCallable());
+}
+
+//! the mouse at the item center zooms both neighbours equally, at the item edge the
+//! neighbour in the mouse direction takes the full zoom and the other one is restored
+void ParabolicEngineTest::hoveredNeighbours()
+{
+    Latte::ParabolicEngine engine;
+    engine.setZoom(ZOOM);
+    ParabolicItems items = registerItems(engine, {true, true, true, true, true});
+
+    QVariantMap scales = engine.applyParabolicEffect(2, CENTER, CENTER);
+    QCOMPARE(engine.currentIndex(), 2);
+    QVERIFY(qFuzzyCompare(scales[QStringLiteral("leftScale")].toReal(), 1.3));
+    QVERIFY(qFuzzyCompare(scales[QStringLiteral("rightScale")].toReal(), 1.3));
+    compareScales(engine, items, {1, 1.3, ZOOM, 1.3, 1});
+
+    engine.applyParabolicEffect(2, 2 * CENTER, CENTER);
+    compareScales(engine, items, {1, 1, ZOOM, ZOOM, 1});
+
+    engine.applyParabolicEffect(3, 0, CENTER);
+    compareScales(engine, items, {1, 1, ZOOM, ZOOM, 1});
+
+    engine.applyParabolicEffect(3, CENTER, CENTER);
+    compareScales(engine, items, {1, 1, 1.3, ZOOM, 1.3});
+
+    engine.clearScales();
+    QCOMPARE(engine.currentIndex(), -1);
+    compareScales(engine, items, {1, 1, 1, 1, 1});
+}
+
+//! separators and hidden items pass the scale to their next neighbour
+void ParabolicEngineTest::skippedItems()
+{
+    Latte::ParabolicEngine engine;
+    engine.setZoom(ZOOM);
+    ParabolicItems items = registerItems(engine, {true, false, true, true, false, true});
+
+    engine.applyParabolicEffect(3, CENTER, CENTER);
+    compareScales(engine, items, {1, 1, 1.3, ZOOM, 1, 1.3});
+
+    engine.applyParabolicEffect(2, CENTER, CENTER);
+    compareScales(engine, items, {1.3, 1, ZOOM, 1.3, 1, 1});
+}
+
+//! indexes stay in model order, only the mouse direction is mirrored
+void ParabolicEngineTest::reversedDirection()
+{
+    Latte::ParabolicEngine engine;
+    engine.setZoom(ZOOM);
+    engine.setReversed(true);
+    ParabolicItems items = registerItems(engine, {true, true, true});
+
+    QVariantMap scales = engine.applyParabolicEffect(1, 2 * CENTER, CENTER);
+    QVERIFY(qFuzzyCompare(scales[QStringLiteral("leftScale")].toReal(), ZOOM));
+    QVERIFY(qFuzzyCompare(scales[QStringLiteral("rightScale")].toReal(), 1));
+    compareScales(engine, items, {ZOOM, ZOOM, 1});
+}
+
+//! docks applets indexes are not continuous between the start, main and end layouts,
+//! scales do not pass to another layout but zoom clearing restores all of them
+void ParabolicEngineTest::layoutsAreNotCrossed()
+{
+    Latte::ParabolicEngine engine;
+    engine.setZoom(ZOOM);
+    ParabolicItems startItems = registerItems(engine, {true, true, true}, 0);
+    ParabolicItems mainItems = registerItems(engine, {true, true, true}, 100);
+
+    QSignalSpy hostHigher(&engine, &Latte::ParabolicEngine::hostUpdateHigherItemScaleRequested);
+    QSignalSpy hostLower(&engine, &Latte::ParabolicEngine::hostUpdateLowerItemScaleRequested);
+
+    engine.applyParabolicEffect(2, CENTER, CENTER);
+    compareScales(engine, startItems, {1, 1.3, ZOOM}, 0);
+    compareScales(engine, mainItems, {1, 1, 1}, 100);
+    QCOMPARE(hostHigher.count(), 0);
+
+    engine.applyParabolicEffect(100, CENTER, CENTER);
+    compareScales(engine, mainItems, {ZOOM, 1.3, 1}, 100);
+    compareScales(engine, startItems, {1, 1.3, ZOOM}, 0);
+
+    //! the lower neighbour is restored, so all lower items are restored too
+    hostLower.clear();
+    engine.applyParabolicEffect(100, 2 * CENTER, CENTER);
+    compareScales(engine, startItems, {1, 1, 1}, 0);
+    QCOMPARE(hostLower.count(), 1);
+    QVERIFY(qFuzzyCompare(hostLower[0][0].toReal(), 1));
+}
+
+//! a Latte Tasks plasmoid inside a dock, the host hands the scales to the tasks and
+//! the tasks provide back the scales that passed them through the applet bridge
+void ParabolicEngineTest::clientEngine()
+{
+    int appletIndex{1};
+
+    Latte::ParabolicEngine host;
+    host.setZoom(ZOOM);
+    Latte::ParabolicEngine tasks;
+    tasks.setZoom(ZOOM);
+
+    ParabolicItems applets = registerItems(host, {true, true, true});
+    ParabolicItems taskItems = registerItems(tasks, {true, true, true});
+    host.setItem(appletIndex, applets[appletIndex].get(), true, &tasks);
+
+    connect(&tasks, &Latte::ParabolicEngine::hostUpdateLowerItemScaleRequested, &host, [&host, appletIndex](qreal newScale, qreal step) {
+        host.updateLowerItemScale(appletIndex - 1, newScale, step);
+    });
+
+    connect(&tasks, &Latte::ParabolicEngine::hostUpdateHigherItemScaleRequested, &host, [&host, appletIndex](qreal newScale, qreal step) {
+        host.updateHigherItemScale(appletIndex + 1, newScale, step);
+    });
+
+    host.applyParabolicEffect(0, 2 * CENTER, CENTER);
+    compareScales(host, applets, {ZOOM, 1, 1});
+    compareScales(tasks, taskItems, {ZOOM, 1, 1});
+
+    tasks.applyParabolicEffect(2, 2 * CENTER, CENTER);
+    compareScales(tasks, taskItems, {1, 1, ZOOM});
+    compareScales(host, applets, {1, 1, ZOOM});
+
+    tasks.applyParabolicEffect(0, 0, CENTER);
+    compareScales(tasks, taskItems, {ZOOM, 1, 1});
+    compareScales(host, applets, {ZOOM, 1, 1});
+
+    //! zoom clearing of the host reaches the tasks
+    host.clearScales();
+    compareScales(tasks, taskItems, {1, 1, 1});
+}
+
+void ParabolicEngineTest::onlyChangedScalesAreNotified()
+{
+    Latte::ParabolicEngine engine;
+    engine.setZoom(ZOOM);
+    ParabolicItems items = registerItems(engine, tasksAccepted(50));
+
+    engine.applyParabolicEffect(20, CENTER, CENTER);
+    engine.applyParabolicEffect(20, CENTER, CENTER);
+    QCOMPARE(changes(items), 3);
+
+    //! moving to the next item changes only the scales around the mouse
+    engine.applyParabolicEffect(21, CENTER, CENTER);
+    QCOMPARE(changes(items), 7);
+}
+
+void ParabolicEngineTest::movedAndDestroyedItems()
+{
+    Latte::ParabolicEngine engine;
+    engine.setZoom(ZOOM);
+    ParabolicItems items = registerItems(engine, {true, true, true, true});
+
+    //! first and last items exchange their positions
+    engine.setItem(3, items[0].get(), true);
+    engine.setItem(0, items[3].get(), true);
+
+    engine.applyParabolicEffect(1, 0, CENTER);
+    QVERIFY(qFuzzyCompare(items[3]->parabolicScale(), ZOOM));
+    QVERIFY(qFuzzyCompare(items[0]->parabolicScale(), 1));
+
+    //! a destroyed item is a gap that stops the scales
+    items[2].reset();
+    engine.applyParabolicEffect(1, 2 * CENTER, CENTER);
+    QVERIFY(qFuzzyCompare(items[0]->parabolicScale(), 1));
+    QVERIFY(qFuzzyCompare(engine.scale(2), 1));
+
+    engine.removeItem(items[1].get());
+    engine.clearScales();
+    QVERIFY(qFuzzyCompare(items[1]->parabolicScale(), ZOOM));
+    QVERIFY(qFuzzyCompare(items[3]->parabolicScale(), 1));
+}
+
+void ParabolicEngineTest::compareWithJavascript_data()
+{
+    QTest::addColumn<QList<bool>>("accepted");
+    QTest::addColumn<bool>("reversed");
+    QTest::addColumn<int>("seed");
+
+    for (int tasks : {2, 5, 12, 50}) {
+        const QByteArray count = QByteArray::number(tasks);
+        QTest::newRow(("tasks-" + count).constData()) << tasksAccepted(tasks) << false << tasks;
+        QTest::newRow(("reversed-" + count).constData()) << tasksAccepted(tasks) << true << tasks + 1;
+    }
+}
+
+void ParabolicEngineTest::compareWithJavascript()
+{
+    QFETCH(QList<bool>, accepted);
+    QFETCH(bool, reversed);
+    QFETCH(int, seed);
+
+    QVariantList jsAccepted;
+
+    for (const bool value : accepted) {
+        jsAccepted << value;
+    }
+
+    QJSValue chain = m_jsCreateChain.call({m_engine.toScriptValue(jsAccepted)});
+    QJSValue jsApply = chain.property(QStringLiteral("applyParabolicEffect"));
+
+    Latte::ParabolicEngine engine;
+    engine.setZoom(ZOOM);
+    engine.setReversed(reversed);
+    ParabolicItems items = registerItems(engine, accepted);
+
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> indexes(0, accepted.count() - 1);
+    std::uniform_real_distribution<qreal> positions(0, 2 * CENTER);
+
+    //! mouse moves are applied sequentially because the previous scales must be updated correctly
+    for (int move=0; move<200; ++move) {
+        int index = indexes(generator);
+
+        //! separators and hidden tasks can not be hovered
+        while (!accepted[index]) {
+            index = indexes(generator);
+        }
+
+        const qreal position = positions(generator);
+
+        const QVariantMap scales = engine.applyParabolicEffect(index, position, CENTER);
+        const QVariantMap jsScales = jsApply.callWithInstance(chain, {index, position, CENTER, ZOOM, reversed}).toVariant().toMap();
+
+        QVERIFY(qFuzzyCompare(scales[QStringLiteral("leftScale")].toReal(), jsScales[QStringLiteral("leftScale")].toReal()));
+        QVERIFY(qFuzzyCompare(scales[QStringLiteral("rightScale")].toReal(), jsScales[QStringLiteral("rightScale")].toReal()));
+
+        QList<qreal> expected;
+
+        for (const auto &scale : chain.property(QStringLiteral("scales")).toVariant().toList()) {
+            expected << scale.toReal();
+        }
+
+        compareScales(engine, items, expected);
+
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+}
+
+void ParabolicEngineTest::benchmarkParabolicEffect_data()
+{
+    QTest::addColumn<bool>("javascript");
+    QTest::addColumn<int>("tasks");
+
+    for (int tasks : {50, 100}) {
+        const QByteArray count = QByteArray::number(tasks);
+        QTest::newRow(("native-" + count).constData()) << false << tasks;
+        QTest::newRow(("javascript-" + count).constData()) << true << tasks;
+    }
+}
+
+//! one iteration is one mouse move, the mouse sweeps all tasks in steps of a quarter of a task
+void ParabolicEngineTest::benchmarkParabolicEffect()
+{
+    QFETCH(bool, javascript);
+    QFETCH(int, tasks);
+
+    const QList<bool> accepted = tasksAccepted(tasks);
+    QList<int> hoverable;
+
+    for (int i=0; i<accepted.count(); ++i) {
+        if (accepted[i]) {
+            hoverable << i;
+        }
+    }
+
+    int frame{0};
+
+    if (javascript) {
+        QVariantList jsAccepted;
+
+        for (const bool value : accepted) {
+            jsAccepted << value;
+        }
+
+        QJSValue chain = m_jsCreateChain.call({m_engine.toScriptValue(jsAccepted)});
+        QJSValue jsApply = chain.property(QStringLiteral("applyParabolicEffect"));
+
+        QBENCHMARK {
+            const int index = hoverable[(frame / 4) % hoverable.count()];
+            jsApply.callWithInstance(chain, {index, (frame % 4) * CENTER / 2, CENTER, ZOOM, false});
+            ++frame;
+        }
+    } else {
+        Latte::ParabolicEngine engine;
+        engine.setZoom(ZOOM);
+        ParabolicItems items = registerItems(engine, accepted);
+
+        QBENCHMARK {
+            const int index = hoverable[(frame / 4) % hoverable.count()];
+            engine.applyParabolicEffect(index, (frame % 4) * CENTER / 2, CENTER);
+            ++frame;
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(ParabolicEngineTest)
+
+#include "parabolicenginetest.moc"
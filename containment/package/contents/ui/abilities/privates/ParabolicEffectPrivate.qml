@@ -36,9 +36,22 @@ ContainerAbility.ParabolicEffect {
 
     readonly property bool horizontal: plasmoid.formFactor === PlasmaCore.Types.Horizontal
 
+    //! applets scales are computed natively, applets indexes are used as they are and
+    //! for right-to-left layouts only the mouse direction is mirrored
+    readonly property LatteCore.ParabolicEngine engine: LatteCore.ParabolicEngine {
+        zoom: parabolic.factor.zoom
+        reversed: Qt.application.layoutDirection === Qt.RightToLeft && parabolic.horizontal
+    }
+
     Connections {
         target: parabolic
-        onSglClearZoom: parabolic._privates.lastIndex = -1;
+        onSglClearZoom: {
+            parabolic._privates.lastIndex = -1;
+            parabolic.engine.clearScales();
+        }
+        //! requests from the Latte Tasks plasmoids through their bridges
+        onSglUpdateLowerItemScale: parabolic.engine.updateLowerItemScale(delegateIndex, newScale, step);
+        onSglUpdateHigherItemScale: parabolic.engine.updateHigherItemScale(delegateIndex, newScale, step);
         onRestoreZoomIsBlockedChanged: {
             if (!parabolic.restoreZoomIsBlocked) {
                 parabolic.startRestoreZoomTimer();
@@ -91,45 +104,7 @@ ContainerAbility.ParabolicEffect {
         //! last item requested calculations
         parabolic._privates.lastIndex = index;
 
-        var rDistance = Math.abs(currentMousePosition  - center);
-
-        //check if the mouse goes right or down according to the center
-        var positiveDirection =  ((currentMousePosition  - center) >= 0 );
-
-        if (Qt.application.layoutDirection === Qt.RightToLeft && horizontal) {
-            positiveDirection = !positiveDirection;
-        }
-
-        //finding the zoom center e.g. for zoom:1.7, calculates 0.35
-        var zoomCenter = (factor.zoom - 1) / 2
-
-        //computes the in the scale e.g. 0...0.35 according to the mouse distance
-        //0.35 on the edge and 0 in the center
-        var firstComputation = (rDistance / center) * zoomCenter;
-
-        //calculates the scaling for the neighbour tasks
-        var bigNeighbourZoom = Math.min(1 + zoomCenter + firstComputation, factor.zoom);
-        var smallNeighbourZoom = Math.max(1 + zoomCenter - firstComputation, 1);
-
-        //bigNeighbourZoom = Number(bigNeighbourZoom.toFixed(4));
-        //smallNeighbourZoom = Number(smallNeighbourZoom.toFixed(4));
-
-        var leftScale;
-        var rightScale;
-
-        if(positiveDirection === true){
-            rightScale = bigNeighbourZoom;
-            leftScale = smallNeighbourZoom;
-        }
-        else {
-            rightScale = smallNeighbourZoom;
-            leftScale = bigNeighbourZoom;
-        }
-
-        sglUpdateHigherItemScale(index+1 , rightScale, 0);
-        sglUpdateLowerItemScale(index-1, leftScale, 0);
-
-        return {leftScale:leftScale, rightScale:rightScale};
+        return engine.applyParabolicEffect(index, currentMousePosition, center);
     }
 
 
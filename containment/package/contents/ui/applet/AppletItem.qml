@@ -54,7 +54,6 @@ Item {
                                             && !isSpacer && !isInternalViewSplitter
 
     //! Fill Applet(s)
-    property bool inFillCalculations: false //temp record, is used in calculations for fillWidth,fillHeight applets
     property bool isAutoFillApplet: {
         if (!applet || !applet.Layout)
             return false;
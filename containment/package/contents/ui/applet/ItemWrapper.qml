@@ -115,6 +115,13 @@ Item{
 
     property real zoomScale: 1
 
+    //! set by the parabolic engine
+    property real parabolicScale: 1
+    readonly property bool parabolicAccepted: !appletItem.isSeparator && !appletItem.isHidden
+    //! Latte Tasks plasmoids compute their tasks scales with their own engine
+    readonly property QtObject parabolicClient: communicator.parabolicEffectIsSupported && communicator.bridge.parabolic.client.engine ?
+                                                    communicator.bridge.parabolic.client.engine : null
+
     property int index: appletItem.index
 
     property Item wrapperContainer: _wrapperContainer
@@ -653,67 +660,27 @@ Item{
         }
     }
 
-    function sltUpdateLowerItemScale(delegateIndex, newScale, step) {
-        if (delegateIndex === appletItem.index) {
-            if (communicator.parabolicEffectIsSupported) {
-                communicator.bridge.parabolic.client.hostRequestUpdateLowerItemScale(newScale, step);
-                return;
-            }
-
-            if (!appletItem.isSeparator && !appletItem.isHidden) {
-                //! when accepted
-                updateScale(delegateIndex, newScale, step);
+    //! scales are provided by the parabolic engine, only when they change
+    onParabolicScaleChanged: updateScale(appletItem.index, parabolicScale, 0);
 
-                if (newScale > 1) { // clear lower items
-                    parabolic.sglUpdateLowerItemScale(delegateIndex-1, 1, 0);
-                }
-            } else {
-                parabolic.sglUpdateLowerItemScale(delegateIndex-1, newScale, step);
-            }
-        } else if ((newScale === 1) && (appletItem.index < delegateIndex)) {
-            //! apply zoom clearing
-            if (communicator.parabolicEffectIsSupported) {
-                communicator.bridge.parabolic.client.hostRequestUpdateLowerItemScale(1, step);
-            } else {
-                updateScale(appletItem.index, 1, 0);
-            }
-        }
+    function registerParabolicItem() {
+        appletItem.parabolic.engine.setItem(index, wrapper, parabolicAccepted, parabolicClient);
     }
 
-    function sltUpdateHigherItemScale(delegateIndex, newScale, step) {
-        if (delegateIndex === appletItem.index) {
-            if (communicator.parabolicEffectIsSupported) {
-                communicator.bridge.parabolic.client.hostRequestUpdateHigherItemScale(newScale, step);
-                return;
-            }
-
-            if (!appletItem.isSeparator && !appletItem.isHidden) {
-                //! when accepted
-                updateScale(delegateIndex, newScale, step);
+    onIndexChanged: registerParabolicItem();
+    onParabolicAcceptedChanged: registerParabolicItem();
+    onParabolicClientChanged: registerParabolicItem();
 
-                if (newScale > 1) { // clear higher items
-                    parabolic.sglUpdateHigherItemScale(delegateIndex+1, 1, 0);
-                }
-            } else {
-                parabolic.sglUpdateHigherItemScale(delegateIndex+1, newScale, step);
-            }
-        } else if ((newScale === 1) && (appletItem.index > delegateIndex)) {
-            //! apply zoom clearing
-            if (communicator.parabolicEffectIsSupported) {
-                communicator.bridge.parabolic.client.hostRequestUpdateHigherItemScale(1, step);
-            } else {
-                updateScale(appletItem.index, 1, 0);
+    Connections {
+        target: appletItem
+        onContainsMouseChanged: {
+            //! scales that were provided while the applet was still hovered
+            if (!appletItem.containsMouse) {
+                wrapper.updateScale(appletItem.index, wrapper.parabolicScale, 0);
             }
         }
     }
 
-    Component.onCompleted: {
-        parabolic.sglUpdateLowerItemScale.connect(sltUpdateLowerItemScale);
-        parabolic.sglUpdateHigherItemScale.connect(sltUpdateHigherItemScale);
-    }
-
-    Component.onDestruction: {
-        parabolic.sglUpdateLowerItemScale.disconnect(sltUpdateLowerItemScale);
-        parabolic.sglUpdateHigherItemScale.disconnect(sltUpdateHigherItemScale);
-    }
+    Component.onCompleted: registerParabolicItem();
+    Component.onDestruction: appletItem.parabolic.engine.removeItem(wrapper);
 }// Main task area // id:wrapper
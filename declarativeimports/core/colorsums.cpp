@@ -0,0 +1,212 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "colorsums.h"
+
+// SIMD
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LATTE_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace Latte {
+
+//! QRgb is 0xAARRGGBB, so in memory each pixel is found as B,G,R,A
+static void colorSumsScalar(const QRgb *pixels, int count, ColorSums &sums)
+{
+    for (int i=0; i<count; ++i) {
+        const int r = qRed(pixels[i]);
+        const int g = qGreen(pixels[i]);
+        const int b = qBlue(pixels[i]);
+        const quint64 weight = 65025 + 9 * qAlpha(pixels[i]) * (qMax(r, qMax(g, b)) - qMin(r, qMin(g, b)));
+
+        sums.red += r * weight;
+        sums.green += g * weight;
+        sums.blue += b * weight;
+        sums.weight += weight;
+    }
+}
+
+#if defined(__SSE2__)
+//! channels are found in the low byte of each 32bit lane, so 8bit min/max and 16bit madd are safe;
+//! products are up to 28bits and they are widened to 64bit through _mm_mul_epu32
+static void colorSumsSse2(const QRgb *pixels, int count, ColorSums &sums)
+{
+    const __m128i channelMask = _mm_set1_epi32(0xFF);
+    const __m128i lowMask = _mm_set_epi32(0, -1, 0, -1);
+    const __m128i baseWeight = _mm_set1_epi32(65025);
+
+    const int vectorEnd = count - (count % 4);
+
+    __m128i red = _mm_setzero_si128();
+    __m128i green = _mm_setzero_si128();
+    __m128i blue = _mm_setzero_si128();
+    __m128i weights = _mm_setzero_si128();
+
+    for (int i=0; i<vectorEnd; i += 4) {
+        const __m128i pixels4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+        const __m128i b = _mm_and_si128(pixels4, channelMask);
+        const __m128i g = _mm_and_si128(_mm_srli_epi32(pixels4, 8), channelMask);
+        const __m128i r = _mm_and_si128(_mm_srli_epi32(pixels4, 16), channelMask);
+        const __m128i a = _mm_srli_epi32(pixels4, 24);
+
+        const __m128i max = _mm_max_epu8(r, _mm_max_epu8(g, b));
+        const __m128i min = _mm_min_epu8(r, _mm_min_epu8(g, b));
+        const __m128i alphaSaturation = _mm_madd_epi16(a, _mm_sub_epi32(max, min));
+        const __m128i weight = _mm_add_epi32(baseWeight, _mm_add_epi32(_mm_slli_epi32(alphaSaturation, 3), alphaSaturation));
+        const __m128i weightOdd = _mm_srli_epi64(weight, 32);
+
+        red = _mm_add_epi64(red, _mm_add_epi64(_mm_mul_epu32(r, weight), _mm_mul_epu32(_mm_srli_epi64(r, 32), weightOdd)));
+        green = _mm_add_epi64(green, _mm_add_epi64(_mm_mul_epu32(g, weight), _mm_mul_epu32(_mm_srli_epi64(g, 32), weightOdd)));
+        blue = _mm_add_epi64(blue, _mm_add_epi64(_mm_mul_epu32(b, weight), _mm_mul_epu32(_mm_srli_epi64(b, 32), weightOdd)));
+        weights = _mm_add_epi64(weights, _mm_add_epi64(_mm_and_si128(weight, lowMask), weightOdd));
+    }
+
+    quint64 lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), red);
+    sums.red += lanes[0] + lanes[1];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), green);
+    sums.green += lanes[0] + lanes[1];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), blue);
+    sums.blue += lanes[0] + lanes[1];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), weights);
+    sums.weight += lanes[0] + lanes[1];
+
+    colorSumsScalar(pixels + vectorEnd, count - vectorEnd, sums);
+}
+#endif
+
+#if defined(LATTE_AVX2_DISPATCH)
+__attribute__((target("avx2")))
+static void colorSumsAvx2(const QRgb *pixels, int count, ColorSums &sums)
+{
+    const __m256i channelMask = _mm256_set1_epi32(0xFF);
+    const __m256i lowMask = _mm256_set_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+    const __m256i baseWeight = _mm256_set1_epi32(65025);
+
+    const int vectorEnd = count - (count % 8);
+
+    __m256i red = _mm256_setzero_si256();
+    __m256i green = _mm256_setzero_si256();
+    __m256i blue = _mm256_setzero_si256();
+    __m256i weights = _mm256_setzero_si256();
+
+    for (int i=0; i<vectorEnd; i += 8) {
+        const __m256i pixels8 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+        const __m256i b = _mm256_and_si256(pixels8, channelMask);
+        const __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixels8, 8), channelMask);
+        const __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixels8, 16), channelMask);
+        const __m256i a = _mm256_srli_epi32(pixels8, 24);
+
+        const __m256i max = _mm256_max_epu8(r, _mm256_max_epu8(g, b));
+        const __m256i min = _mm256_min_epu8(r, _mm256_min_epu8(g, b));
+        const __m256i alphaSaturation = _mm256_madd_epi16(a, _mm256_sub_epi32(max, min));
+        const __m256i weight = _mm256_add_epi32(baseWeight, _mm256_add_epi32(_mm256_slli_epi32(alphaSaturation, 3), alphaSaturation));
+
+        //! products are up to 28bits, they are split in even/odd lanes in order to be accumulated in 64bit
+        const __m256i redProducts = _mm256_mullo_epi32(r, weight);
+        const __m256i greenProducts = _mm256_mullo_epi32(g, weight);
+        const __m256i blueProducts = _mm256_mullo_epi32(b, weight);
+
+        red = _mm256_add_epi64(red, _mm256_add_epi64(_mm256_and_si256(redProducts, lowMask), _mm256_srli_epi64(redProducts, 32)));
+        green = _mm256_add_epi64(green, _mm256_add_epi64(_mm256_and_si256(greenProducts, lowMask), _mm256_srli_epi64(greenProducts, 32)));
+        blue = _mm256_add_epi64(blue, _mm256_add_epi64(_mm256_and_si256(blueProducts, lowMask), _mm256_srli_epi64(blueProducts, 32)));
+        weights = _mm256_add_epi64(weights, _mm256_add_epi64(_mm256_and_si256(weight, lowMask), _mm256_srli_epi64(weight, 32)));
+    }
+
+    quint64 lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), red);
+    sums.red += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), green);
+    sums.green += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), blue);
+    sums.blue += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), weights);
+    sums.weight += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    colorSumsScalar(pixels + vectorEnd, count - vectorEnd, sums);
+}
+#endif
+
+bool colorSumsKernelIsSupported(ColorSumsKernel kernel)
+{
+    switch (kernel) {
+    case ColorSumsKernel::Scalar:
+        return true;
+    case ColorSumsKernel::Sse2:
+#if defined(__SSE2__)
+        return true;
+#else
+        return false;
+#endif
+    case ColorSumsKernel::Avx2:
+#if defined(LATTE_AVX2_DISPATCH)
+    {
+        static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+        return hasAvx2;
+    }
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+void colorSums(const QRgb *pixels, int count, ColorSums &sums, ColorSumsKernel kernel)
+{
+    if (!pixels || count <= 0) {
+        return;
+    }
+
+    if (!colorSumsKernelIsSupported(kernel)) {
+        kernel = ColorSumsKernel::Scalar;
+    }
+
+    switch (kernel) {
+#if defined(LATTE_AVX2_DISPATCH)
+    case ColorSumsKernel::Avx2:
+        colorSumsAvx2(pixels, count, sums);
+        return;
+#endif
+#if defined(__SSE2__)
+    case ColorSumsKernel::Sse2:
+        colorSumsSse2(pixels, count, sums);
+        return;
+#endif
+    default:
+        colorSumsScalar(pixels, count, sums);
+        return;
+    }
+}
+
+void colorSums(const QRgb *pixels, int count, ColorSums &sums)
+{
+    static const ColorSumsKernel bestKernel = colorSumsKernelIsSupported(ColorSumsKernel::Avx2) ? ColorSumsKernel::Avx2 :
+                                             (colorSumsKernelIsSupported(ColorSumsKernel::Sse2) ? ColorSumsKernel::Sse2 : ColorSumsKernel::Scalar);
+
+    colorSums(pixels, count, sums, bestKernel);
+}
+
+}
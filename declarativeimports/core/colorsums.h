@@ -0,0 +1,56 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LATTECOLORSUMS_H
+#define LATTECOLORSUMS_H
+
+// Qt
+#include <QColor>
+
+namespace Latte {
+
+//! Weighted channel sums that are used to identify the icon dominant color.
+//! Each pixel weight is the original float relevance (.1 + .9 * alpha * saturation)
+//! scaled by 650250, that way the sums are integer exact and the produced
+//! averages are identical to the float ones
+struct ColorSums {
+    quint64 red{0};
+    quint64 green{0};
+    quint64 blue{0};
+    quint64 weight{0};
+};
+
+enum class ColorSumsKernel {
+    Scalar = 0,
+    Sse2,
+    Avx2
+};
+
+//! adds the weighted sums of consecutive pixels, it is vectorized when the cpu supports it
+void colorSums(const QRgb *pixels, int count, ColorSums &sums);
+
+//! kernels are exposed in order to be verified and benchmarked against each other,
+//! unsupported kernels from the build or the running cpu fall back to the scalar one
+bool colorSumsKernelIsSupported(ColorSumsKernel kernel);
+void colorSums(const QRgb *pixels, int count, ColorSums &sums, ColorSumsKernel kernel);
+
+}
+
+#endif
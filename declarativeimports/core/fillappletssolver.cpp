@@ -0,0 +1,453 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "fillappletssolver.h"
+
+// Qt
+#include <QtMath>
+
+#define LAYOUTSCOUNT 3
+
+namespace Latte{
+
+FillAppletsSolver::FillAppletsSolver(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool FillAppletsSolver::justify() const
+{
+    return m_justify;
+}
+
+void FillAppletsSolver::setJustify(bool justify)
+{
+    if (m_justify == justify) {
+        return;
+    }
+
+    m_justify = justify;
+    emit justifyChanged();
+}
+
+int FillAppletsSolver::thickness() const
+{
+    return m_thickness;
+}
+
+void FillAppletsSolver::setThickness(int thickness)
+{
+    if (m_thickness == thickness) {
+        return;
+    }
+
+    m_thickness = thickness;
+    emit thicknessChanged();
+}
+
+int FillAppletsSolver::maxLength() const
+{
+    return m_maxLength;
+}
+
+void FillAppletsSolver::setMaxLength(int length)
+{
+    if (m_maxLength == length) {
+        return;
+    }
+
+    m_maxLength = length;
+    emit maxLengthChanged();
+}
+
+int FillAppletsSolver::minLength() const
+{
+    return m_minLength;
+}
+
+void FillAppletsSolver::setMinLength(int length)
+{
+    if (m_minLength == length) {
+        return;
+    }
+
+    m_minLength = length;
+    emit minLengthChanged();
+}
+
+int &FillAppletsSolver::autoFillLength(Applet &applet, bool inMaxAutoFillCalculations)
+{
+    return inMaxAutoFillCalculations ? applet.maxAutoFillLength : applet.minAutoFillLength;
+}
+
+//! auto fill lengths are int properties in qml, non finite lengths are converted
+//! to zero the same way qml does instead of overflowing
+int FillAppletsSolver::autoFillLengthValue(qreal length)
+{
+    return qIsFinite(length) ? static_cast<int>(length) : 0;
+}
+
+//! qBound style function that is specialized in Layouts
+//! meaning that -1 values are ignored for fillWidth(s)/Height(s)
+qreal FillAppletsSolver::appletPreferredLength(qreal min, qreal pref, qreal max)
+{
+    if (max == -1) {
+        max = (pref == -1) ? min : pref;
+    }
+
+    if (pref == -1) {
+        pref = (max == -1) ? min : pref;
+    }
+
+    return qMin(qMax(min, pref), max);
+}
+
+//! initialize applets flag "inFillCalculations" in order
+//! to inform them that new calculations are taking place
+void FillAppletsSolver::initLayoutForFillsCalculations(Layout &layout)
+{
+    for (auto &applet : layout.applets) {
+        applet.inFillCalculations = true;
+    }
+}
+
+//! during step1/pass1 all applets that provide valid metrics (minimum/preferred/maximum values)
+//! they gain a valid space in order to draw themeselves
+FillAppletsSolver::Step FillAppletsSolver::computeStep1ForLayout(Layout &layout, Step step, bool inMaxAutoFillCalculations) const
+{
+    for (auto &applet : layout.applets) {
+        if (!applet.hasMetrics) {
+            continue;
+        }
+
+        qreal minSize = (applet.minimum >= 0 && !qIsInf(applet.minimum)) ? applet.minimum : -1;
+        qreal prefSize = (minSize >= 0 && !qIsInf(applet.preferred)) ? applet.preferred : -1;
+        qreal maxSize = (applet.maximum >= 0 && !qIsInf(applet.maximum)) ? applet.maximum : -1;
+
+        //! applets that do not provide any valid metrics are decided from the system
+        //! after the applets that provide nice metrics are assigned their sizes
+        if (minSize < 0 && prefSize < 0 && maxSize < 0) {
+            continue;
+        }
+
+        qreal appliedSize = -1;
+
+        if (step.noOfApplets > 1) {
+            appliedSize = appletPreferredLength(minSize, prefSize, maxSize);
+        } else if (step.noOfApplets == 1) {
+            //! when only one applet has remained, its maximum size must not exceed the available space
+            //! in order for the applet to not be drawn outside the boundaries
+            appliedSize = appletPreferredLength(minSize, prefSize, qMin(maxSize, step.sizePerApplet));
+        }
+
+        //! appliedSize must be also lower than the sizePerApplet, if it is not lower then
+        //! for this applet the needed space will be provided during the second pass in a fair way
+        //! between all remained applets that did not gain a valid fill space
+        if (appliedSize >= 0 && appliedSize <= step.sizePerApplet) {
+            qreal properSize = qMin(appliedSize, step.availableSpace);
+            autoFillLength(applet, inMaxAutoFillCalculations) = applet.isHidden ? 0 : static_cast<int>(qMax(static_cast<qreal>(m_thickness), properSize));
+            applet.inFillCalculations = false;
+
+            //! the maximum length is always the one that is consumed from the available space
+            step.availableSpace = qMax(0.0, step.availableSpace - applet.maxAutoFillLength);
+            step.noOfApplets = step.noOfApplets - 1;
+            step.sizePerApplet = step.noOfApplets > 1 ? qFloor(step.availableSpace / step.noOfApplets) : step.availableSpace;
+        }
+    }
+
+    return step;
+}
+
+//! during step2/pass2 all the applets with fills
+//! that remained with no computations from pass1
+//! are updated with the algorithm's proposed size
+void FillAppletsSolver::computeStep2ForLayout(Layout &layout, qreal sizePerApplet, int noOfApplets, bool inMaxAutoFillCalculations) const
+{
+    if (sizePerApplet < 0) {
+        return;
+    }
+
+    if (noOfApplets != 0) {
+        for (auto &applet : layout.applets) {
+            if (applet.inFillCalculations) {
+                autoFillLength(applet, inMaxAutoFillCalculations) = autoFillLengthValue(sizePerApplet);
+                applet.inFillCalculations = false;
+            }
+        }
+
+        return;
+    }
+
+    //! when all applets have assigned some size and there is still free space, we must find
+    //! the most demanding space applet and assign the remaining space to it
+    Applet *mostDemandingApplet{nullptr};
+    int mostDemandingAppletSize{0};
+
+    //! applets with no strong opinion
+    QVector<Applet *> neutralApplets;
+
+    for (auto &applet : layout.applets) {
+        if (!applet.hasMetrics) {
+            continue;
+        }
+
+        bool isNeutral = (applet.minimum <= 0 && applet.preferred <= 0);
+        int appletSize = autoFillLength(applet, inMaxAutoFillCalculations);
+
+        //! the most demanding applet is the one that has maximum size set to Infinity
+        //! AND is not Neutral, meaning that it provided some valid metrics
+        //! AND at the same time gained from step one the biggest space
+        if (!isNeutral && qIsInf(applet.maximum) && appletSize > mostDemandingAppletSize) {
+            mostDemandingApplet = &applet;
+            mostDemandingAppletSize = appletSize;
+        } else if (isNeutral) {
+            neutralApplets << &applet;
+        }
+    }
+
+    if (mostDemandingApplet) {
+        //! the most demanding applet gains all the remaining space
+        int &length = autoFillLength(*mostDemandingApplet, inMaxAutoFillCalculations);
+        length = autoFillLengthValue(length + sizePerApplet);
+    } else if (!neutralApplets.isEmpty()) {
+        //! if no demanding applet was found then the available space is splitted equally
+        //! between all neutral applets
+        qreal adjustedAppletSize = sizePerApplet / neutralApplets.count();
+
+        for (auto applet : neutralApplets) {
+            int &length = autoFillLength(*applet, inMaxAutoFillCalculations);
+            length = autoFillLengthValue(length + adjustedAppletSize);
+        }
+    }
+}
+
+//! initialize the three layouts and execute the step1/phase1
+//! it is used when the Centered (Main)Layout is used only or when the Main(Layout)
+//! is empty in Justify mode
+FillAppletsSolver::Step FillAppletsSolver::initializationPhase(Layout *layouts, Step step, bool inMaxAutoFillCalculations) const
+{
+    if (m_justify) {
+        initLayoutForFillsCalculations(layouts[Start]);
+        initLayoutForFillsCalculations(layouts[End]);
+    }
+
+    initLayoutForFillsCalculations(layouts[Main]);
+
+    //! first pass in order to update sizes for applet that want to fill space
+    //! but their maximum metrics are lower than the sizePerApplet
+    step = computeStep1ForLayout(layouts[Main], step, inMaxAutoFillCalculations);
+
+    if (m_justify) {
+        step = computeStep1ForLayout(layouts[Start], step, inMaxAutoFillCalculations);
+        step = computeStep1ForLayout(layouts[End], step, inMaxAutoFillCalculations);
+    }
+
+    return step;
+}
+
+void FillAppletsSolver::updateFillAppletsWithOneStep(Layout *layouts, bool inMaxAutoFillCalculations) const
+{
+    const qreal max_length = inMaxAutoFillCalculations ? m_maxLength : m_minLength;
+
+    Step step;
+    step.noOfApplets = layouts[Start].fillApplets + layouts[Main].fillApplets + layouts[End].fillApplets;
+    step.availableSpace = qMax(0.0, max_length
+                               - layouts[Start].sizeWithNoFillApplets
+                               - layouts[Main].sizeWithNoFillApplets
+                               - layouts[End].sizeWithNoFillApplets);
+    step.sizePerApplet = step.availableSpace / step.noOfApplets;
+
+    step = initializationPhase(layouts, step, inMaxAutoFillCalculations);
+
+    //! after step1 there is a chance that all applets were assigned a valid space
+    //! but at the same time some space remained free. In such case we make sure
+    //! that remained space will be assigned to the most demanding applet.
+    //! For step2 passing noOfApplets!=0 means default step2 behavior BUT
+    //! noOfApplets=0 means that remained space must be also assigned at the end.
+    bool remainedSpace = (step.noOfApplets == 0 && step.sizePerApplet > 0);
+
+    int startNo{-1};
+    int mainNo{-1};
+    int endNo{-1};
+
+    if (remainedSpace) {
+        if (layouts[Start].fillApplets > 0) {
+            startNo = 0;
+        } else if (layouts[End].fillApplets > 0) {
+            endNo = 0;
+        } else if (layouts[Main].fillApplets > 0) {
+            mainNo = 0;
+        }
+    }
+
+    //! second pass in order to update sizes for applet that want to fill space
+    //! these applets get the direct division of the available free space that
+    //! remained from step1 OR the the free available space that no applet requested yet
+    computeStep2ForLayout(layouts[Start], step.sizePerApplet, startNo, inMaxAutoFillCalculations);
+    computeStep2ForLayout(layouts[Main], step.sizePerApplet, mainNo, inMaxAutoFillCalculations);
+    computeStep2ForLayout(layouts[End], step.sizePerApplet, endNo, inMaxAutoFillCalculations);
+}
+
+void FillAppletsSolver::updateFillAppletsWithTwoSteps(Layout *layouts, bool inMaxAutoFillCalculations) const
+{
+    Layout &startLayout = layouts[Start];
+    Layout &mainLayout = layouts[Main];
+    Layout &endLayout = layouts[End];
+
+    const int noA = startLayout.fillApplets + mainLayout.fillApplets + endLayout.fillApplets;
+    const qreal max_length = inMaxAutoFillCalculations ? m_maxLength : m_minLength;
+
+    //! compute the two free spaces around the centered layout
+    //! they are called start and end accordingly
+    qreal halfMainLayout = mainLayout.sizeWithNoFillApplets / 2;
+    qreal availableSpaceStart = qMax(0.0, max_length/2 - startLayout.sizeWithNoFillApplets - halfMainLayout);
+    qreal availableSpaceEnd = qMax(0.0, max_length/2 - endLayout.sizeWithNoFillApplets - halfMainLayout);
+    qreal availableSpace;
+
+    if (mainLayout.fillApplets == 0 || (startLayout.shownApplets == 0 && endLayout.shownApplets == 0)) {
+        //! no fill applets in main OR we are in alignment that all applets are in main
+        availableSpace = availableSpaceStart + availableSpaceEnd - mainLayout.sizeWithNoFillApplets;
+    } else {
+        //! use the minimum available space in order to avoid overlaps
+        availableSpace = 2 * qMin(availableSpaceStart, availableSpaceEnd) - mainLayout.sizeWithNoFillApplets;
+    }
+
+    Step stepMain;
+    stepMain.availableSpace = availableSpace;
+    stepMain.sizePerApplet = mainLayout.fillApplets > 0 ? availableSpace / noA : 0;
+    stepMain.noOfApplets = mainLayout.fillApplets;
+
+    //! initialize the computations
+    for (int i=0; i<LAYOUTSCOUNT; ++i) {
+        initLayoutForFillsCalculations(layouts[i]);
+    }
+
+    //! first pass
+    if (mainLayout.fillApplets > 0) {
+        stepMain = computeStep1ForLayout(mainLayout, stepMain, inMaxAutoFillCalculations);
+        qreal dif = (availableSpace - stepMain.availableSpace) / 2;
+        availableSpaceStart = availableSpaceStart - dif;
+        availableSpaceEnd = availableSpaceEnd - dif;
+    }
+
+    Step stepStart;
+    stepStart.availableSpace = availableSpaceStart;
+    stepStart.noOfApplets = startLayout.fillApplets;
+    stepStart.sizePerApplet = startLayout.fillApplets > 0 ? availableSpaceStart / stepStart.noOfApplets : 0;
+
+    Step stepEnd;
+    stepEnd.availableSpace = availableSpaceEnd;
+    stepEnd.noOfApplets = endLayout.fillApplets;
+    stepEnd.sizePerApplet = endLayout.fillApplets > 0 ? availableSpaceEnd / stepEnd.noOfApplets : 0;
+
+    if (startLayout.fillApplets > 0) {
+        stepStart = computeStep1ForLayout(startLayout, stepStart, inMaxAutoFillCalculations);
+    }
+
+    if (endLayout.fillApplets > 0) {
+        stepEnd = computeStep1ForLayout(endLayout, stepEnd, inMaxAutoFillCalculations);
+    }
+
+    //! second pass
+    if (mainLayout.fillApplets > 0) {
+        computeStep2ForLayout(mainLayout, stepMain.sizePerApplet, stepMain.noOfApplets, inMaxAutoFillCalculations);
+    }
+
+    if (startLayout.fillApplets > 0) {
+        if (mainLayout.fillApplets > 0) {
+            //! adjust final fill applet size in mainlayouts final length
+            stepStart.sizePerApplet = ((max_length/2) - (mainLayout.length/2) - startLayout.sizeWithNoFillApplets) / stepStart.noOfApplets;
+        }
+
+        computeStep2ForLayout(startLayout, stepStart.sizePerApplet, stepStart.noOfApplets, inMaxAutoFillCalculations);
+    }
+
+    if (endLayout.fillApplets > 0) {
+        if (mainLayout.fillApplets > 0) {
+            //! adjust final fill applet size in mainlayouts final length
+            stepEnd.sizePerApplet = ((max_length/2) - (mainLayout.length/2) - endLayout.sizeWithNoFillApplets) / stepEnd.noOfApplets;
+        }
+
+        computeStep2ForLayout(endLayout, stepEnd.sizePerApplet, stepEnd.noOfApplets, inMaxAutoFillCalculations);
+    }
+}
+
+QVariantList FillAppletsSolver::solve(const QVariantList &layoutsData) const
+{
+    Layout layouts[LAYOUTSCOUNT];
+
+    for (int i=0; i<qMin(LAYOUTSCOUNT, layoutsData.count()); ++i) {
+        const QVariantMap data = layoutsData[i].toMap();
+        const QVariantList applets = data.value(QStringLiteral("applets")).toList();
+
+        layouts[i].fillApplets = data.value(QStringLiteral("fillApplets")).toInt();
+        layouts[i].shownApplets = data.value(QStringLiteral("shownApplets")).toInt();
+        layouts[i].sizeWithNoFillApplets = data.value(QStringLiteral("sizeWithNoFillApplets")).toReal();
+        layouts[i].length = data.value(QStringLiteral("length")).toReal();
+        layouts[i].applets.reserve(applets.count());
+
+        for (const auto &appletData : applets) {
+            const QVariantMap appletMap = appletData.toMap();
+
+            Applet applet;
+            applet.hasMetrics = appletMap.value(QStringLiteral("hasMetrics")).toBool();
+            applet.isHidden = appletMap.value(QStringLiteral("isHidden")).toBool();
+            applet.minimum = appletMap.value(QStringLiteral("minimum"), -1).toReal();
+            applet.preferred = appletMap.value(QStringLiteral("preferred"), -1).toReal();
+            applet.maximum = appletMap.value(QStringLiteral("maximum"), -1).toReal();
+            applet.maxAutoFillLength = appletMap.value(QStringLiteral("maxAutoFillLength"), -1).toInt();
+            applet.minAutoFillLength = appletMap.value(QStringLiteral("minAutoFillLength"), -1).toInt();
+
+            layouts[i].applets << applet;
+        }
+    }
+
+    const int noA = layouts[Start].fillApplets + layouts[Main].fillApplets + layouts[End].fillApplets;
+
+    if (noA > 0) {
+        const bool use_maximum_length{true};
+
+        if (layouts[Main].shownApplets == 0 || !m_justify) {
+            updateFillAppletsWithOneStep(layouts, use_maximum_length);
+            updateFillAppletsWithOneStep(layouts, !use_maximum_length);
+        } else {
+            //! Justify mode in all remaining cases
+            updateFillAppletsWithTwoSteps(layouts, use_maximum_length);
+            updateFillAppletsWithTwoSteps(layouts, !use_maximum_length);
+        }
+    }
+
+    QVariantList result;
+
+    for (int i=0; i<LAYOUTSCOUNT; ++i) {
+        QVariantList lengths;
+        lengths.reserve(2 * layouts[i].applets.count());
+
+        for (const auto &applet : layouts[i].applets) {
+            lengths << applet.maxAutoFillLength << applet.minAutoFillLength;
+        }
+
+        result << QVariant(lengths);
+    }
+
+    return result;
+}
+
+}
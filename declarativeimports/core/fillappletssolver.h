@@ -0,0 +1,132 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LATTEFILLAPPLETSSOLVER_H
+#define LATTEFILLAPPLETSSOLVER_H
+
+// Qt
+#include <QObject>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+
+namespace Latte{
+
+//! Computes the lengths of the applets that are requesting fillWidth/fillHeight
+//! for all three layouts (start/main/end) in one native call. The containment
+//! provides a batch with the fill applets metrics of each layout and receives
+//! their maximum and minimum auto fill lengths back.
+class FillAppletsSolver final: public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool justify READ justify WRITE setJustify NOTIFY justifyChanged)
+
+    //! applets thickness, any fill applet is not smaller than it
+    Q_PROPERTY(int thickness READ thickness WRITE setThickness NOTIFY thicknessChanged)
+
+    //! lengths used for maximum and minimum auto fill calculations accordingly
+    Q_PROPERTY(int maxLength READ maxLength WRITE setMaxLength NOTIFY maxLengthChanged)
+    Q_PROPERTY(int minLength READ minLength WRITE setMinLength NOTIFY minLengthChanged)
+
+public:
+    explicit FillAppletsSolver(QObject *parent = nullptr);
+
+    bool justify() const;
+    void setJustify(bool justify);
+
+    int thickness() const;
+    void setThickness(int thickness);
+
+    int maxLength() const;
+    void setMaxLength(int length);
+
+    int minLength() const;
+    void setMinLength(int length);
+
+public slots:
+    //! layouts: [start, main, end], each one is a map with
+    //!   fillApplets, shownApplets, sizeWithNoFillApplets, length and
+    //!   applets: the fill applets in their visual order, each one is a map with
+    //!     hasMetrics, minimum, preferred, maximum, isHidden, maxAutoFillLength, minAutoFillLength
+    //! returns [start, main, end], each one is a flat list of
+    //!   [maxAutoFillLength, minAutoFillLength] pairs, one pair for each fill applet
+    Q_INVOKABLE QVariantList solve(const QVariantList &layouts) const;
+
+signals:
+    void justifyChanged();
+    void maxLengthChanged();
+    void minLengthChanged();
+    void thicknessChanged();
+
+private:
+    struct Applet {
+        bool hasMetrics{false};
+        bool isHidden{false};
+        bool inFillCalculations{false};
+        qreal minimum{-1};
+        qreal preferred{-1};
+        qreal maximum{-1};
+        int maxAutoFillLength{-1};
+        int minAutoFillLength{-1};
+    };
+
+    struct Layout {
+        int fillApplets{0};
+        int shownApplets{0};
+        qreal sizeWithNoFillApplets{0};
+        qreal length{0};
+        QVector<Applet> applets;
+    };
+
+    struct Step {
+        qreal availableSpace{0};
+        qreal sizePerApplet{0};
+        int noOfApplets{0};
+    };
+
+    enum LayoutPosition {
+        Start = 0,
+        Main,
+        End
+    };
+
+    static int &autoFillLength(Applet &applet, bool inMaxAutoFillCalculations);
+    static int autoFillLengthValue(qreal length);
+    static qreal appletPreferredLength(qreal min, qreal pref, qreal max);
+    static void initLayoutForFillsCalculations(Layout &layout);
+
+    Step computeStep1ForLayout(Layout &layout, Step step, bool inMaxAutoFillCalculations) const;
+    void computeStep2ForLayout(Layout &layout, qreal sizePerApplet, int noOfApplets, bool inMaxAutoFillCalculations) const;
+
+    Step initializationPhase(Layout *layouts, Step step, bool inMaxAutoFillCalculations) const;
+    void updateFillAppletsWithOneStep(Layout *layouts, bool inMaxAutoFillCalculations) const;
+    void updateFillAppletsWithTwoSteps(Layout *layouts, bool inMaxAutoFillCalculations) const;
+
+private:
+    bool m_justify{false};
+    int m_thickness{0};
+    int m_maxLength{0};
+    int m_minLength{0};
+};
+
+}
+
+#endif
@@ -23,24 +23,133 @@
 #include "iconitem.h"
 
 // local
+#include "colorsums.h"
 #include "extras.h"
 
 // Qt
+#include <QCache>
+#include <QDateTime>
 #include <QDebug>
+#include <QFileInfo>
+#include <QHash>
+#include <QLoggingCategory>
 #include <QPainter>
 #include <QPaintEngine>
 #include <QQuickWindow>
 #include <QPixmap>
 #include <QSGSimpleTextureNode>
+#include <QtMath>
 #include <QuickAddons/ManagedTextureNode>
 
 // KDE
 #include <KIconTheme>
 #include <KIconThemes/KIconLoader>
 #include <KIconThemes/KIconEffect>
+#include <Plasma/Theme>
+
+//! colors that are cached for all IconItems, when it is exceeded the cache is cleared
+#define MAXCOLORSCACHESIZE 500
+//! KBs of pixmaps that are cached for all IconItems, least recently used pixmaps are dropped first
+#define MAXPIXMAPSCACHECOST 20480
+//! while resizing continuously, icons bigger than that are rendered in buckets of PIXMAPSIZESTEP pixels
+#define MAXEXACTPIXMAPSIZE 32
+#define PIXMAPSIZESTEP 8
+//! ms after the last resize that the size is considered settled and the icon is rendered at its exact size
+#define PIXMAPSIZESETTLEINTERVAL 100
+//! pixmap cache lookups between two hit rate reports for each window
+#define PIXMAPSCACHEREPORTINTERVAL 500
+
+//! pixmap cache hit rates are reported only when they are requested, e.g.
+//! QT_LOGGING_RULES="org.kde.latte.iconitem.pixmaps.debug=true"
+Q_LOGGING_CATEGORY(LATTE_ICONITEM_PIXMAPS, "org.kde.latte.iconitem.pixmaps", QtWarningMsg)
 
 namespace Latte {
 
+struct IconColors {
+    QColor background;
+    QColor glow;
+};
+
+//! process-wide cache, identical icons are analysed only once
+static QHash<QString, IconColors> s_iconColors;
+
+//! process-wide cache of rendered icons, it is created on demand and it is cleared
+//! before application exit in order to not release pixmaps after the platform
+static QCache<QString, QPixmap> *sharedPixmaps()
+{
+    static QCache<QString, QPixmap> *pixmaps{nullptr};
+
+    if (!pixmaps) {
+        pixmaps = new QCache<QString, QPixmap>(MAXPIXMAPSCACHECOST);
+
+        QObject::connect(qApp, &QCoreApplication::aboutToQuit, []() {
+            pixmaps->clear();
+        });
+    }
+
+    return pixmaps;
+}
+
+//! icon/plasma theme changes can alter icons with identical keys
+static void clearSharedCaches()
+{
+    sharedPixmaps()->clear();
+    s_iconColors.clear();
+}
+
+//! during continuous resizes e.g. parabolic zoom, icons are rendered at the smallest bucket
+//! that can contain them and the texture is scaled down to the item size, that way the
+//! same pixmaps are reused instead of rasterizing them again for every frame
+static int pixmapSizeBucket(qreal size)
+{
+    const int exactSize = qCeil(size);
+
+    if (exactSize <= MAXEXACTPIXMAPSIZE) {
+        return exactSize;
+    }
+
+    return ((exactSize + PIXMAPSIZESTEP - 1) / PIXMAPSIZESTEP) * PIXMAPSIZESTEP;
+}
+
+struct PixmapCacheStats {
+    int hits{0};
+    int misses{0};
+};
+
+static QHash<QQuickWindow *, PixmapCacheStats> s_pixmapCacheStats;
+
+//! reports the pixmap cache hit rate for each dock/panel window
+static void trackPixmapCacheLookup(QQuickWindow *window, bool hit)
+{
+    if (!window) {
+        return;
+    }
+
+    if (!s_pixmapCacheStats.contains(window)) {
+        QObject::connect(window, &QObject::destroyed, [window]() {
+            s_pixmapCacheStats.remove(window);
+        });
+    }
+
+    PixmapCacheStats &stats = s_pixmapCacheStats[window];
+
+    if (hit) {
+        stats.hits++;
+    } else {
+        stats.misses++;
+    }
+
+    const int lookups = stats.hits + stats.misses;
+
+    if (lookups >= PIXMAPSCACHEREPORTINTERVAL) {
+        qCDebug(LATTE_ICONITEM_PIXMAPS) << "IconItem pixmaps cache :: window:" << window << window->title()
+                 << " hits:" << stats.hits << " misses:" << stats.misses
+                 << " hit rate:" << QString::number(100.0 * stats.hits / lookups, 'f', 1) + "%"
+                 << " cached KBs:" << sharedPixmaps()->totalCost();
+        stats = PixmapCacheStats();
+    }
+}
+
 IconItem::IconItem(QQuickItem *parent)
     : QQuickItem(parent),
       m_lastValidSourceName(QString()),
@@ -58,6 +167,9 @@ IconItem::IconItem(QQuickItem *parent)
             this, SIGNAL(implicitHeightChanged()));
     connect(this, &QQuickItem::enabledChanged,
             this, &IconItem::enabledChanged);
+
+    connect(KIconLoader::global(), &KIconLoader::iconLoaderSettingsChanged, this, &clearSharedCaches);
+    connect(KIconLoader::global(), &KIconLoader::iconChanged, this, &clearSharedCaches);
     connect(this, &QQuickItem::windowChanged,
             this, &IconItem::schedulePixmapUpdate);
     connect(this, SIGNAL(overlaysChanged()),
@@ -69,6 +181,10 @@ IconItem::IconItem(QQuickItem *parent)
     setImplicitWidth(KIconLoader::global()->currentSize(KIconLoader::Dialog));
     setImplicitHeight(KIconLoader::global()->currentSize(KIconLoader::Dialog));
     setSmooth(true);
+
+    m_sizeSettleTimer.setSingleShot(true);
+    m_sizeSettleTimer.setInterval(PIXMAPSIZESETTLEINTERVAL);
+    connect(&m_sizeSettleTimer, &QTimer::timeout, this, &IconItem::onSizeSettled);
 }
 
 IconItem::~IconItem()
@@ -99,6 +215,7 @@ void IconItem::setSource(const QVariant &source)
         if (url.isLocalFile()) {
             m_icon = QIcon();
             m_imageIcon = QImage(url.path());
+            m_imageIconLastModified = QFileInfo(url.path()).lastModified().toMSecsSinceEpoch();
             m_svgIconName.clear();
             m_svgIcon.reset();
         } else {
@@ -109,6 +226,7 @@ void IconItem::setSource(const QVariant &source)
                 m_svgIcon->setUsingRenderingCache(false);
                 m_svgIcon->setDevicePixelRatio((window() ? window()->devicePixelRatio() : qApp->devicePixelRatio()));
                 connect(m_svgIcon.get(), &Plasma::Svg::repaintNeeded, this, &IconItem::schedulePixmapUpdate);
+                connect(m_svgIcon->theme(), &Plasma::Theme::themeChanged, this, &clearSharedCaches);
             }
 
             if (m_usesPlasmaTheme) {
@@ -426,39 +544,91 @@ void IconItem::setGlowColor(QColor glow)
     emit glowColorChanged();
 }
 
-void IconItem::updateColors()
+QString IconItem::sourceCacheKey() const
 {
-    QImage icon = m_iconPixmap.toImage();
+    QString identity;
 
-    if (icon.format() != QImage::Format_Invalid) {
-        float rtotal = 0, gtotal = 0, btotal = 0;
-        float total = 0.0f;
+    if (m_svgIcon) {
+        identity = QLatin1String("svg:") + m_svgIconName + QLatin1Char(':') + QString::number(m_usesPlasmaTheme)
+                + QLatin1Char(':') + m_svgIcon->theme()->themeName() + QLatin1Char(':') + QString::number(m_colorGroup);
+    } else if (!m_icon.isNull()) {
+        identity = m_icon.name().isEmpty() ? QLatin1String("icon:") + QString::number(m_icon.cacheKey())
+                                           : QLatin1String("icon:") + m_icon.name();
+    } else if (!m_imageIcon.isNull()) {
+        QUrl url(m_source.toString());
+        identity = url.isLocalFile() ? QLatin1String("file:") + url.path() + QLatin1Char(':') + QString::number(m_imageIconLastModified)
+                                     : QLatin1String("image:") + QString::number(m_imageIcon.cacheKey());
+    } else {
+        return QString();
+    }
 
-        for(int row=0; row<icon.height(); ++row) {
-            QRgb *line = (QRgb *)icon.scanLine(row);
+    const auto *iconTheme = KIconLoader::global()->theme();
+
+    return identity
+            + QLatin1Char('|') + (iconTheme ? iconTheme->internalName() : QString())
+            + QLatin1Char('|') + QString::number(isEnabled()) + QString::number(m_active)
+            + QLatin1Char('|') + m_overlays.join(QLatin1Char(','));
+}
+
+QString IconItem::colorsCacheKey() const
+{
+    const QString source = sourceCacheKey();
+
+    if (source.isEmpty()) {
+        return QString();
+    }
 
-            for(int col=0; col<icon.width(); ++col) {
-                QRgb pix = line[col];
+    return source + QLatin1Char('|') + QString::number(m_iconPixmap.width()) + QLatin1Char('x') + QString::number(m_iconPixmap.height());
+}
 
-                int r = qRed(pix);
-                int g = qGreen(pix);
-                int b = qBlue(pix);
-                int a = qAlpha(pix);
+QString IconItem::pixmapCacheKey(int size, qreal devicePixelRatio) const
+{
+    const QString source = sourceCacheKey();
 
-                float saturation = (qMax(r, qMax(g, b)) - qMin(r, qMin(g, b))) / 255.0f;
-                float relevance = .1 + .9 * (a / 255.0f) * saturation;
+    if (source.isEmpty()) {
+        return QString();
+    }
 
-                rtotal += (float)(r * relevance);
-                gtotal += (float)(g * relevance);
-                btotal += (float)(b * relevance);
+    //! images are not rendered for a specific size, so they are cached only once
+    if (!m_svgIcon && m_icon.isNull() && !m_imageIcon.isNull()) {
+        return source;
+    }
 
-                total += relevance * 255;
-            }
+    return source + QLatin1Char('|') + QString::number(size) + QLatin1Char('@') + QString::number(devicePixelRatio);
+}
+
+void IconItem::updateColors()
+{
+    const QString key = colorsCacheKey();
+
+    if (!key.isEmpty() && s_iconColors.contains(key)) {
+        const IconColors &colors = s_iconColors[key];
+        setBackgroundColor(colors.background);
+        setGlowColor(colors.glow);
+        return;
+    }
+
+    QImage icon = m_iconPixmap.toImage();
+
+    if (icon.format() != QImage::Format_Invalid) {
+        //! the kernel reads QRgb values directly, so any non 32bit format must be converted first
+        if (icon.depth() != 32) {
+            icon = icon.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        }
+
+        ColorSums sums;
+
+        for(int row=0; row<icon.height(); ++row) {
+            colorSums(reinterpret_cast<const QRgb *>(icon.constScanLine(row)), icon.width(), sums);
+        }
+
+        if (sums.weight == 0) {
+            return;
         }
 
-        int nr = (rtotal / total) * 255;
-        int ng = (gtotal / total) * 255;
-        int nb = (btotal / total) * 255;
+        int nr = static_cast<int>(sums.red / sums.weight);
+        int ng = static_cast<int>(sums.green / sums.weight);
+        int nb = static_cast<int>(sums.blue / sums.weight);
 
         QColor tempColor(nr, ng, nb);
 
@@ -468,11 +638,23 @@ void IconItem::updateColors()
 
         tempColor.setHsvF(tempColor.hueF(), tempColor.saturationF(), 0.55f); //original 0.90f ???
 
-        setBackgroundColor(tempColor);
+        IconColors colors;
+        colors.background = tempColor;
 
         tempColor.setHsvF(tempColor.hueF(), tempColor.saturationF(), 1.0f);
 
-        setGlowColor(tempColor);
+        colors.glow = tempColor;
+
+        if (!key.isEmpty()) {
+            if (s_iconColors.count() >= MAXCOLORSCACHESIZE) {
+                s_iconColors.clear();
+            }
+
+            s_iconColors[key] = colors;
+        }
+
+        setBackgroundColor(colors.background);
+        setGlowColor(colors.glow);
     }
 }
 
@@ -490,65 +672,89 @@ void IconItem::loadPixmap()
         m_iconPixmap = QPixmap();
         update();
         return;
-    } else if (m_svgIcon) {
-        m_svgIcon->resize(size, size);
-
-        if (m_svgIcon->hasElement(m_svgIconName)) {
-            result = m_svgIcon->pixmap(m_svgIconName);
-        } else if (!m_svgIconName.isEmpty()) {
-            const auto *iconTheme = KIconLoader::global()->theme();
-            QString iconPath;
-
-            if (iconTheme) {
-                iconPath = iconTheme->iconPath(m_svgIconName + QLatin1String(".svg")
-                                               , static_cast<int>(qMin(width(), height()))
-                                               , KIconLoader::MatchBest);
-
-                if (iconPath.isEmpty()) {
-                    iconPath = iconTheme->iconPath(m_svgIconName + QLatin1String(".svgz"),
-                                                   static_cast<int>(qMin(width(), height()))
+    } else if (!m_svgIcon && m_icon.isNull() && m_imageIcon.isNull()) {
+        m_iconPixmap = QPixmap();
+        update();
+        return;
+    }
+
+    //! icons are sharp at rest, buckets are used only while the size is changing continuously
+    const int pixmapSize = m_sizeAnimating ? pixmapSizeBucket(size) : static_cast<int>(size);
+    const qreal devicePixelRatio = window() ? window()->devicePixelRatio() : qApp->devicePixelRatio();
+    const QString pixmapKey = pixmapCacheKey(pixmapSize, devicePixelRatio);
+
+    QPixmap *cachedPixmap = !pixmapKey.isEmpty() ? sharedPixmaps()->object(pixmapKey) : nullptr;
+
+    if (LATTE_ICONITEM_PIXMAPS().isDebugEnabled()) {
+        trackPixmapCacheLookup(window(), cachedPixmap != nullptr);
+    }
+
+    if (cachedPixmap) {
+        result = *cachedPixmap;
+    } else {
+        if (m_svgIcon) {
+            m_svgIcon->resize(pixmapSize, pixmapSize);
+
+            if (m_svgIcon->hasElement(m_svgIconName)) {
+                result = m_svgIcon->pixmap(m_svgIconName);
+            } else if (!m_svgIconName.isEmpty()) {
+                const auto *iconTheme = KIconLoader::global()->theme();
+                QString iconPath;
+
+                if (iconTheme) {
+                    iconPath = iconTheme->iconPath(m_svgIconName + QLatin1String(".svg")
+                                                   , pixmapSize
                                                    , KIconLoader::MatchBest);
+
+                    if (iconPath.isEmpty()) {
+                        iconPath = iconTheme->iconPath(m_svgIconName + QLatin1String(".svgz"),
+                                                       pixmapSize
+                                                       , KIconLoader::MatchBest);
+                    }
+                } else {
+                    qWarning() << "KIconLoader has no theme set";
                 }
-            } else {
-                qWarning() << "KIconLoader has no theme set";
+
+                if (!iconPath.isEmpty()) {
+                    m_svgIcon->setImagePath(iconPath);
+                }
+
+                result = m_svgIcon->pixmap();
             }
+        } else if (!m_icon.isNull()) {
+            result = m_icon.pixmap(QSize(pixmapSize, pixmapSize) * devicePixelRatio);
+        } else if (!m_imageIcon.isNull()) {
+            result = QPixmap::fromImage(m_imageIcon);
+        }
 
-            if (!iconPath.isEmpty()) {
-                m_svgIcon->setImagePath(iconPath);
+        // Strangely KFileItem::overlays() returns empty string-values, so
+        // we need to check first whether an overlay must be drawn at all.
+        // It is more efficient to do it here, as KIconLoader::drawOverlays()
+        // assumes that an overlay will be drawn and has some additional
+        // setup time.
+        for (const QString &overlay : m_overlays) {
+            if (!overlay.isEmpty()) {
+                // There is at least one overlay, draw all overlays above m_pixmap
+                // and cancel the check
+                KIconLoader::global()->drawOverlays(m_overlays, result, KIconLoader::Desktop);
+                break;
             }
+        }
 
-            result = m_svgIcon->pixmap();
+        if (!isEnabled()) {
+            result = KIconLoader::global()->iconEffect()->apply(result, KIconLoader::Desktop, KIconLoader::DisabledState);
+        } else if (m_active) {
+            result = KIconLoader::global()->iconEffect()->apply(result, KIconLoader::Desktop, KIconLoader::ActiveState);
         }
-    } else if (!m_icon.isNull()) {
-        result = m_icon.pixmap(QSize(static_cast<int>(size), static_cast<int>(size))
-                               * (window() ? window()->devicePixelRatio() : qApp->devicePixelRatio()));
-    } else if (!m_imageIcon.isNull()) {
-        result = QPixmap::fromImage(m_imageIcon);
-    } else {
-        m_iconPixmap = QPixmap();
-        update();
-        return;
-    }
 
-    // Strangely KFileItem::overlays() returns empty string-values, so
-    // we need to check first whether an overlay must be drawn at all.
-    // It is more efficient to do it here, as KIconLoader::drawOverlays()
-    // assumes that an overlay will be drawn and has some additional
-    // setup time.
-    for (const QString &overlay : m_overlays) {
-        if (!overlay.isEmpty()) {
-            // There is at least one overlay, draw all overlays above m_pixmap
-            // and cancel the check
-            KIconLoader::global()->drawOverlays(m_overlays, result, KIconLoader::Desktop);
-            break;
+        if (!pixmapKey.isEmpty() && !result.isNull()) {
+            const int cost = qMax(1, result.width() * result.height() * result.depth() / (8 * 1024));
+            sharedPixmaps()->insert(pixmapKey, new QPixmap(result), cost);
         }
     }
 
-    if (!isEnabled()) {
-        result = KIconLoader::global()->iconEffect()->apply(result, KIconLoader::Desktop, KIconLoader::DisabledState);
-    } else if (m_active) {
-        result = KIconLoader::global()->iconEffect()->apply(result, KIconLoader::Desktop, KIconLoader::ActiveState);
-    }
+    //! when the same pixmap is already uploaded as texture, only its painted rect must be updated
+    const bool textureChanged = result.isNull() || result.cacheKey() != m_iconPixmap.cacheKey();
 
     m_iconPixmap = result;
 
@@ -557,7 +763,10 @@ void IconItem::loadPixmap()
         updateColors();
     }
 
-    m_textureChanged = true;
+    if (textureChanged) {
+        m_textureChanged = true;
+    }
+
     //don't animate initial setting
     update();
 }
@@ -572,6 +781,13 @@ void IconItem::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeome
     if (newGeometry.size() != oldGeometry.size()) {
         m_sizeChanged = true;
 
+        //! a resize that follows another one shortly is part of a continuous resize
+        if (m_sizeSettleTimer.isActive()) {
+            m_sizeAnimating = true;
+        }
+
+        m_sizeSettleTimer.start();
+
         if (newGeometry.width() > 1 && newGeometry.height() > 1) {
             schedulePixmapUpdate();
         } else {
@@ -589,6 +805,16 @@ void IconItem::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeome
     QQuickItem::geometryChanged(newGeometry, oldGeometry);
 }
 
+void IconItem::onSizeSettled()
+{
+    if (!m_sizeAnimating) {
+        return;
+    }
+
+    m_sizeAnimating = false;
+    schedulePixmapUpdate();
+}
+
 void IconItem::componentComplete()
 {
     QQuickItem::componentComplete();
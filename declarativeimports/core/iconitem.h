@@ -31,6 +31,7 @@
 #include <QIcon>
 #include <QImage>
 #include <QPixmap>
+#include <QTimer>
 
 // Plasma
 #include <Plasma/Svg>
@@ -171,10 +172,17 @@ signals:
 private slots:
     void schedulePixmapUpdate();
     void enabledChanged();
+    void onSizeSettled();
 
 private:
     void loadPixmap();
     void updateColors();
+    //! identifies the current source and its state in the shared caches
+    QString sourceCacheKey() const;
+    //! identifies the icon colors in the shared colors cache
+    QString colorsCacheKey() const;
+    //! identifies the rendered icon in the shared pixmaps cache
+    QString pixmapCacheKey(int size, qreal devicePixelRatio) const;
     void setLastLoadedSourceId(QString id);
     void setLastValidSourceName(QString name);
     void setBackgroundColor(QColor background);
@@ -188,6 +196,8 @@ private:
 
     bool m_textureChanged;
     bool m_sizeChanged;
+    //! the size is changing continuously e.g. parabolic zoom, pixmaps are rendered in size buckets
+    bool m_sizeAnimating{false};
     bool m_usesPlasmaTheme;
 
     QColor m_backgroundColor;
@@ -196,6 +206,8 @@ private:
     QIcon m_icon;
     QPixmap m_iconPixmap;
     QImage m_imageIcon;
+    //! modification time of the local file that m_imageIcon was read from
+    qint64 m_imageIconLastModified{0};
     std::unique_ptr<Plasma::Svg> m_svgIcon;
     QString m_svgIconName;
 
@@ -222,6 +234,8 @@ private:
     QVariant m_source;
 
     QSizeF m_implicitSize;
+
+    QTimer m_sizeSettleTimer;
 };
 
 }
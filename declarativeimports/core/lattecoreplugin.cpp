@@ -22,7 +22,9 @@
 
 // local
 #include "environment.h"
+#include "fillappletssolver.h"
 #include "iconitem.h"
+#include "parabolicengine.h"
 #include "quickwindowsystem.h"
 #include "tools.h"
 
@@ -36,7 +38,9 @@ void LatteCorePlugin::registerTypes(const char *uri)
 {
     Q_ASSERT(uri == QLatin1String("org.kde.latte.core"));
     qmlRegisterUncreatableType<Latte::Types>(uri, 0, 2, "Types", "Latte Types uncreatable");
+    qmlRegisterType<Latte::FillAppletsSolver>(uri, 0, 2, "FillAppletsSolver");
     qmlRegisterType<Latte::IconItem>(uri, 0, 2, "IconItem");
+    qmlRegisterType<Latte::ParabolicEngine>(uri, 0, 2, "ParabolicEngine");
     qmlRegisterSingletonType<Latte::Environment>(uri, 0, 2, "Environment", &Latte::environment_qobject_singletontype_provider);
     qmlRegisterSingletonType<Latte::Tools>(uri, 0, 2, "Tools", &Latte::tools_qobject_singletontype_provider);
     qmlRegisterSingletonType<Latte::QuickWindowSystem>(uri, 0, 2, "WindowSystem", &Latte::windowsystem_qobject_singletontype_provider);
@@ -0,0 +1,308 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "parabolicengine.h"
+
+// C++
+#include <limits>
+
+#define SCALEPROPERTY "parabolicScale"
+
+namespace Latte{
+
+ParabolicEngine::ParabolicEngine(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool ParabolicEngine::reversed() const
+{
+    return m_reversed;
+}
+
+void ParabolicEngine::setReversed(bool reversed)
+{
+    if (m_reversed == reversed) {
+        return;
+    }
+
+    m_reversed = reversed;
+    emit reversedChanged();
+}
+
+int ParabolicEngine::currentIndex() const
+{
+    return m_currentIndex;
+}
+
+void ParabolicEngine::setCurrentIndex(int index)
+{
+    if (m_currentIndex == index) {
+        return;
+    }
+
+    m_currentIndex = index;
+    emit currentIndexChanged();
+}
+
+qreal ParabolicEngine::zoom() const
+{
+    return m_zoom;
+}
+
+void ParabolicEngine::setZoom(qreal zoom)
+{
+    if (qFuzzyCompare(m_zoom, zoom)) {
+        return;
+    }
+
+    m_zoom = zoom;
+    emit zoomChanged();
+}
+
+bool ParabolicEngine::isRegistered(const Item &item) const
+{
+    return !item.target.isNull();
+}
+
+void ParabolicEngine::setItem(int index, QObject *target, bool accepted, QObject *client)
+{
+    if (!target) {
+        return;
+    }
+
+    if (index < 0) {
+        removeItem(target);
+        return;
+    }
+
+    auto previous = m_indexes.constFind(target);
+
+    if (previous == m_indexes.constEnd()) {
+        connect(target, &QObject::destroyed, this, &ParabolicEngine::removeItem, Qt::UniqueConnection);
+    } else if (previous.value() != index) {
+        //! the item moved, e.g. after a tasks reordering
+        auto previousItem = m_items.find(previous.value());
+
+        if (previousItem != m_items.end() && (!isRegistered(*previousItem) || previousItem->target == target)) {
+            m_items.erase(previousItem);
+        }
+    }
+
+    Item &item = m_items[index];
+
+    if (item.target != target) {
+        if (isRegistered(item)) {
+            //! the previous target will be registered again when its own index is updated
+            m_indexes.remove(item.target);
+        }
+
+        bool valid{false};
+        const qreal scale = target->property(SCALEPROPERTY).toReal(&valid);
+
+        item.target = target;
+        item.scale = valid && scale > 0 ? scale : 1.0;
+    }
+
+    item.accepted = accepted;
+    item.client = qobject_cast<ParabolicEngine *>(client);
+
+    m_indexes[target] = index;
+}
+
+void ParabolicEngine::removeItem(QObject *target)
+{
+    auto index = m_indexes.find(target);
+
+    if (index == m_indexes.end()) {
+        return;
+    }
+
+    auto item = m_items.find(index.value());
+
+    //! destroyed targets are already null at this point
+    if (item != m_items.end() && (!isRegistered(*item) || item->target == target)) {
+        m_items.erase(item);
+    }
+
+    m_indexes.erase(index);
+
+    disconnect(target, &QObject::destroyed, this, &ParabolicEngine::removeItem);
+}
+
+QVariantMap ParabolicEngine::applyParabolicEffect(int index, qreal currentMousePosition, qreal center)
+{
+    setCurrentIndex(index);
+
+    const qreal rDistance = qAbs(currentMousePosition - center);
+
+    //! check if the mouse goes right or down according to the center
+    bool positiveDirection = ((currentMousePosition - center) >= 0);
+
+    if (m_reversed) {
+        positiveDirection = !positiveDirection;
+    }
+
+    //! finding the zoom center e.g. for zoom:1.7, calculates 0.35
+    const qreal zoomCenter = (m_zoom - 1) / 2;
+
+    //! computes the in the scale e.g. 0...0.35 according to the mouse distance
+    //! 0.35 on the edge and 0 in the center
+    const qreal firstComputation = (rDistance / center) * zoomCenter;
+
+    //! calculates the scaling for the neighbour items
+    const qreal bigNeighbourZoom = qMin(1 + zoomCenter + firstComputation, m_zoom);
+    const qreal smallNeighbourZoom = qMax(1 + zoomCenter - firstComputation, 1.0);
+
+    const qreal leftScale = positiveDirection ? smallNeighbourZoom : bigNeighbourZoom;
+    const qreal rightScale = positiveDirection ? bigNeighbourZoom : smallNeighbourZoom;
+
+    //! the hovered item applies the zoom by itself, it is tracked in order to notify it
+    //! properly when one of its neighbours is hovered afterwards
+    auto hovered = m_items.find(index);
+
+    if (hovered != m_items.end() && isRegistered(*hovered) && !hovered->client) {
+        setItemScale(*hovered, m_zoom);
+    }
+
+    updateHigherItemScale(index + 1, rightScale, 0);
+    updateLowerItemScale(index - 1, leftScale, 0);
+
+    QVariantMap scales;
+    scales[QStringLiteral("leftScale")] = leftScale;
+    scales[QStringLiteral("rightScale")] = rightScale;
+
+    return scales;
+}
+
+void ParabolicEngine::updateLowerItemScale(int index, qreal newScale, qreal step)
+{
+    if (qFuzzyCompare(newScale, 1.0)) {
+        //! zoom clearing, all lower items are restored
+        clearItemScales(std::numeric_limits<int>::min(), index);
+        emit hostUpdateLowerItemScaleRequested(1, step);
+        return;
+    }
+
+    for (int i=index; ; --i) {
+        if (m_items.isEmpty() || i < m_items.firstKey()) {
+            //! the scale passed the first item
+            emit hostUpdateLowerItemScaleRequested(newScale, step);
+            return;
+        }
+
+        auto item = m_items.find(i);
+
+        if (item == m_items.end() || !isRegistered(*item)) {
+            //! the layout ended, e.g. between the start and main layouts of a dock
+            return;
+        }
+
+        if (item->client) {
+            ParabolicEngine *client = item->client;
+            client->updateLowerItemScale(client->m_items.isEmpty() ? -1 : client->m_items.lastKey(), newScale, step);
+            return;
+        }
+
+        if (item->accepted) {
+            setItemScale(*item, newScale + step);
+            clearItemScales(std::numeric_limits<int>::min(), i - 1);
+            emit hostUpdateLowerItemScaleRequested(1, 0);
+            return;
+        }
+    }
+}
+
+void ParabolicEngine::updateHigherItemScale(int index, qreal newScale, qreal step)
+{
+    if (qFuzzyCompare(newScale, 1.0)) {
+        //! zoom clearing, all higher items are restored
+        clearItemScales(index, std::numeric_limits<int>::max());
+        emit hostUpdateHigherItemScaleRequested(1, step);
+        return;
+    }
+
+    for (int i=index; ; ++i) {
+        if (m_items.isEmpty() || i > m_items.lastKey()) {
+            //! the scale passed the last item
+            emit hostUpdateHigherItemScaleRequested(newScale, step);
+            return;
+        }
+
+        auto item = m_items.find(i);
+
+        if (item == m_items.end() || !isRegistered(*item)) {
+            //! the layout ended, e.g. between the main and end layouts of a dock
+            return;
+        }
+
+        if (item->client) {
+            ParabolicEngine *client = item->client;
+            client->updateHigherItemScale(client->m_items.isEmpty() ? 0 : client->m_items.firstKey(), newScale, step);
+            return;
+        }
+
+        if (item->accepted) {
+            setItemScale(*item, newScale + step);
+            clearItemScales(i + 1, std::numeric_limits<int>::max());
+            emit hostUpdateHigherItemScaleRequested(1, 0);
+            return;
+        }
+    }
+}
+
+void ParabolicEngine::clearScales()
+{
+    setCurrentIndex(-1);
+    clearItemScales(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+}
+
+void ParabolicEngine::clearItemScales(int from, int to)
+{
+    for (auto item = m_items.lowerBound(from); item != m_items.end() && item.key() <= to; ++item) {
+        if (item->client) {
+            item->client->clearItemScales(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+        } else {
+            setItemScale(*item, 1.0);
+        }
+    }
+}
+
+void ParabolicEngine::setItemScale(Item &item, qreal scale)
+{
+    if (qFuzzyCompare(item.scale, scale)) {
+        return;
+    }
+
+    item.scale = scale;
+
+    if (item.target) {
+        item.target->setProperty(SCALEPROPERTY, scale);
+    }
+}
+
+qreal ParabolicEngine::scale(int index) const
+{
+    auto item = m_items.constFind(index);
+
+    return item != m_items.constEnd() ? item->scale : 1.0;
+}
+
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LATTEPARABOLICENGINE_H
+#define LATTEPARABOLICENGINE_H
+
+// Qt
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QPointer>
+#include <QVariantMap>
+
+namespace Latte{
+
+//! Computes the parabolic zoom factors of all items of a dock or a tasks plasmoid in
+//! one native pass. It replaces the signals chain that was broadcasted to every item
+//! for every hovered position. Items register themselves with setItem() and then they
+//! receive only their own scale through their "parabolicScale" property and only when
+//! it changes.
+//!
+//! Indexes are always in model order, exactly as the items delegates indexes. "reversed"
+//! does not reorder anything, it only mirrors the mouse direction for right-to-left
+//! horizontal layouts the same way the qml implementation was doing.
+//!
+//! An item can be a client engine, e.g. a Latte Tasks plasmoid inside a dock. Scales that
+//! reach such an item are passed to the client engine and scales that pass the first or
+//! the last item of a client are provided back through the host*Requested signals.
+class ParabolicEngine final: public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool reversed READ reversed WRITE setReversed NOTIFY reversedChanged)
+
+    Q_PROPERTY(int currentIndex READ currentIndex NOTIFY currentIndexChanged)
+
+    Q_PROPERTY(qreal zoom READ zoom WRITE setZoom NOTIFY zoomChanged)
+
+public:
+    explicit ParabolicEngine(QObject *parent = nullptr);
+
+    bool reversed() const;
+    void setReversed(bool reversed);
+
+    int currentIndex() const;
+
+    qreal zoom() const;
+    void setZoom(qreal zoom);
+
+public slots:
+    //! accepted is false for items that pass the scales to their neighbours, e.g. separators and hidden items
+    Q_INVOKABLE void setItem(int index, QObject *target, bool accepted, QObject *client = nullptr);
+    Q_INVOKABLE void removeItem(QObject *target);
+
+    //! returns the scales of the hovered item neighbours as {leftScale, rightScale}
+    Q_INVOKABLE QVariantMap applyParabolicEffect(int index, qreal currentMousePosition, qreal center);
+
+    Q_INVOKABLE void updateLowerItemScale(int index, qreal newScale, qreal step);
+    Q_INVOKABLE void updateHigherItemScale(int index, qreal newScale, qreal step);
+
+    Q_INVOKABLE void clearScales();
+
+    Q_INVOKABLE qreal scale(int index) const;
+
+signals:
+    void currentIndexChanged();
+    void reversedChanged();
+    void zoomChanged();
+
+    //! scales that passed the first or the last item and must be applied by the host
+    void hostUpdateLowerItemScaleRequested(qreal newScale, qreal step);
+    void hostUpdateHigherItemScaleRequested(qreal newScale, qreal step);
+
+private:
+    struct Item {
+        bool accepted{true};
+        qreal scale{1.0};
+        QPointer<QObject> target;
+        QPointer<ParabolicEngine> client;
+    };
+
+    bool isRegistered(const Item &item) const;
+
+    void setCurrentIndex(int index);
+    void setItemScale(Item &item, qreal scale);
+
+    //! clears all items with indexes in [from, to], client engines included
+    void clearItemScales(int from, int to);
+
+private:
+    bool m_reversed{false};
+    int m_currentIndex{-1};
+    qreal m_zoom{1.6};
+
+    //! sorted by index, applets indexes in docks are not continuous between layouts
+    QMap<int, Item> m_items;
+    QHash<QObject *, int> m_indexes;
+};
+
+}
+
+#endif
@@ -75,6 +75,9 @@ Item{
     property bool inTempScaling: ((tempScaleWidth !== 1) || (tempScaleHeight !== 1) )
 
     property real mScale: 1
+    //! set by the parabolic engine
+    property real parabolicScale: 1
+    readonly property bool parabolicAccepted: !taskItem.isSeparator && !taskItem.isHidden
     property real tempScaleWidth: 1
     property real tempScaleHeight: 1
 
@@ -216,41 +219,26 @@ Item{
         }
     }
 
-    function sltUpdateLowerItemScale(delegateIndex, newScale, step) {
-        if (delegateIndex === index) {
-            if (!taskItem.isSeparator && !taskItem.isHidden) {
-                //! when accepted
-                updateScale(delegateIndex, newScale, step);
+    //! scales are provided by the parabolic engine, only when they change
+    onParabolicScaleChanged: updateScale(index, parabolicScale, 0);
 
-                if (newScale > 1) { // clear lower items
-                    taskItem.parabolic.sglUpdateLowerItemScale(delegateIndex-1, 1, 0);
-                }
-            } else {
-                taskItem.parabolic.sglUpdateLowerItemScale(delegateIndex-1, newScale, step);
-            }
-        } else if ((newScale === 1) && (index < delegateIndex)) {
-            updateScale(index, 1, 0);
-        }
+    function registerParabolicItem() {
+        taskItem.parabolic.engine.setItem(index, wrapper, parabolicAccepted);
     }
 
-    function sltUpdateHigherItemScale(delegateIndex, newScale, step) {
-        if (delegateIndex === index) {
-            if (!taskItem.isSeparator && !taskItem.isHidden) {
-                //! when accepted
-                updateScale(delegateIndex, newScale, step);
+    onParabolicAcceptedChanged: registerParabolicItem();
 
-                if (newScale > 1) { // clear lower items
-                    taskItem.parabolic.sglUpdateHigherItemScale(delegateIndex+1, 1, 0); // clear higher items
-                }
-            } else {
-                taskItem.parabolic.sglUpdateHigherItemScale(delegateIndex+1, newScale, step);
+    Connections {
+        target: taskItem
+        onItemIndexChanged: wrapper.registerParabolicItem();
+        onContainsMouseChanged: {
+            //! scales that were provided while the task was still hovered
+            if (!taskItem.containsMouse) {
+                wrapper.updateScale(index, wrapper.parabolicScale, 0);
             }
-        } else if ((newScale === 1) && (index > delegateIndex)) {
-            updateScale(index, 1, 0);
         }
     }
 
-
     function sendEndOfNeedBothAxisAnimation(){
         if (taskItem.isZoomed) {
             taskItem.isZoomed = false;
@@ -290,12 +278,8 @@ Item{
             opacity = 1;
         }
 
-        taskItem.parabolic.sglUpdateLowerItemScale.connect(sltUpdateLowerItemScale);
-        taskItem.parabolic.sglUpdateHigherItemScale.connect(sltUpdateHigherItemScale);
+        registerParabolicItem();
     }
 
-    Component.onDestruction: {
-        taskItem.parabolic.sglUpdateLowerItemScale.disconnect(sltUpdateLowerItemScale);
-        taskItem.parabolic.sglUpdateHigherItemScale.disconnect(sltUpdateHigherItemScale);
-    }
+    Component.onDestruction: taskItem.parabolic.engine.removeItem(wrapper);
 }// Main task area // id:wrapper